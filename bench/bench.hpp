@@ -0,0 +1,40 @@
+#ifndef NEARGYE_SEMANTIC_VERSIONING_BENCH_HPP
+#define NEARGYE_SEMANTIC_VERSIONING_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+#if !defined(__GNUC__)
+inline const void* volatile sink = nullptr;
+#endif
+
+// Prevents the compiler from dropping the computation of `value`.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  sink = &value;
+#endif
+}
+
+// Runs `f` `iterations` times and prints the mean time per iteration.
+template <typename F>
+inline double run(const char* name, std::size_t iterations, F&& f) {
+  for (std::size_t i = 0; i < iterations / 10; ++i) {
+    f();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    f();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+
+  const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(iterations);
+  std::printf("%-48s %12.1f ns\n", name, ns);
+  return ns;
+}
+
+#endif // NEARGYE_SEMANTIC_VERSIONING_BENCH_HPP
@@ -0,0 +1,76 @@
+#include <semver.hpp>
+#include "bench.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+int main() {
+  constexpr std::size_t iterations = 200000;
+  constexpr std::array<std::string_view, 4> texts = { {
+    "1.2.3",
+    "10.20.30",
+    "1.0.0-alpha.beta.1",
+    "2.0.0-rc.1+build.123",
+  } };
+
+  std::vector<char> buffer(256);
+  char* current = buffer.data();
+  for (auto text : texts) {
+    semver::version<> v;
+    if (!semver::parse(text, v)) {
+      return EXIT_FAILURE;
+    }
+    const auto result = semver::serialize(current, buffer.data() + buffer.size(), v);
+    if (!result) {
+      return EXIT_FAILURE;
+    }
+    current = result.ptr;
+  }
+  const char* const last = current;
+
+  semver::version<> v;
+  const double parse_ns = run("parse 4 versions", iterations, [&] {
+    for (auto text : texts) {
+      const auto result = semver::parse(text, v);
+      do_not_optimize(result);
+      do_not_optimize(v);
+    }
+  });
+
+  const double deserialize_ns = run("deserialize 4 versions", iterations, [&] {
+    for (const char* first = buffer.data(); first != last;) {
+      const auto result = semver::deserialize(first, last, v);
+      do_not_optimize(v);
+      first = result.ptr;
+    }
+  });
+
+  std::printf("%-48s %12.1fx\n", "speedup", parse_ns / deserialize_ns);
+
+  semver::range_set<> range;
+  if (!semver::parse(">=1.2.3 <2.0.0-0 || ~3.1.0-beta.2", range)) {
+    return EXIT_FAILURE;
+  }
+  const auto range_end = semver::serialize(buffer.data(), buffer.data() + buffer.size(), range);
+  if (!range_end) {
+    return EXIT_FAILURE;
+  }
+
+  run("parse range", iterations, [&] {
+    semver::range_set<> r;
+    const auto result = semver::parse(">=1.2.3 <2.0.0-0 || ~3.1.0-beta.2", r);
+    do_not_optimize(result);
+    do_not_optimize(r);
+  });
+
+  run("deserialize range", iterations, [&] {
+    semver::range_set<> r;
+    const auto result = semver::deserialize(buffer.data(), static_cast<const char*>(range_end.ptr), r);
+    do_not_optimize(result);
+    do_not_optimize(r);
+  });
+
+  return EXIT_SUCCESS;
+}
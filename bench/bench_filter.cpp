@@ -0,0 +1,66 @@
+#include <semver.hpp>
+#include "bench.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+int main() {
+  constexpr std::size_t iterations = 200;
+  constexpr std::size_t rows = 100000;
+
+  // mostly releases, every 16th a prerelease, spread over a few majors
+  std::vector<semver::version<>> versions;
+  versions.reserve(rows);
+  std::uint32_t state = 2024;
+  for (std::size_t i = 0; i < rows; ++i) {
+    state = state * 1664525U + 1013904223U;
+    std::string text = std::to_string(state % 7) + "." + std::to_string((state >> 8) % 20) + "." + std::to_string((state >> 16) % 50);
+    if (i % 16 == 0) {
+      text += "-rc.1";
+    }
+    semver::version<> v;
+    if (!semver::parse(text, v)) {
+      return EXIT_FAILURE;
+    }
+    versions.push_back(v);
+  }
+  const semver::version_table<> table{ versions.begin(), versions.end() };
+
+  semver::range_set<> range;
+  if (!semver::parse(">=1.2.0 <3.0.0-0 || ^5.1.0 || 6.4.x", range)) {
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::size_t> expected;
+  const double contains_ns = run("contains, row by row (100k rows)", iterations, [&] {
+    expected.clear();
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+      if (range.contains(versions[i])) {
+        expected.push_back(i);
+      }
+    }
+    do_not_optimize(expected.data());
+  });
+
+  std::vector<std::size_t> indices;
+  const double filter_ns = run("filter, column by column (100k rows)", iterations, [&] {
+    range.filter(table, indices);
+    do_not_optimize(indices.data());
+  });
+
+  std::vector<bool> bitmap;
+  run("filter into a bitmap (100k rows)", iterations, [&] {
+    range.filter(table, bitmap);
+    do_not_optimize(bitmap);
+  });
+
+  if (indices != expected) {
+    return EXIT_FAILURE;
+  }
+
+  std::printf("%-48s %12.1fx\n", "speedup", contains_ns / filter_ns);
+  std::printf("  %zu of %zu rows match\n", indices.size(), rows);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,31 @@
+#include <semver.hpp>
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <string>
+
+int main() {
+  constexpr std::size_t iterations = 20;
+  constexpr std::size_t lines = 200000;
+
+  std::string text;
+  for (std::size_t i = 0; i < lines; ++i) {
+    if (i % 20 == 0) {
+      text += "2024-01-01T00:00:00.123Z pulled node:" + std::to_string(i % 30) + "." + std::to_string(i % 10) + ".0-alpine\n";
+    } else {
+      text += "2024-01-01T00:00:00.123Z GET /api/v1/items 200 0.031s from 10.0.0." + std::to_string(i % 255) + "\n";
+    }
+  }
+
+  std::size_t found = 0;
+  const double ns = run("find_all (200k log lines)", iterations, [&] {
+    found = semver::find_all(text, [](std::string_view match, const semver::static_version<>& v) {
+      do_not_optimize(match);
+      do_not_optimize(v);
+    });
+    do_not_optimize(found);
+  });
+  std::printf("  %zu versions in %zu bytes, %.2f GB/min\n", found, text.size(), static_cast<double>(text.size()) / ns * 60.0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+#include <semver_resolver.hpp>
+#include "bench.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// A module graph like a large Go workspace: every module has four minor releases, and each
+// release requires a few modules further down at a random minor, so most modules are
+// reached at several versions and the walk has to merge them.
+struct module_graph {
+  std::vector<std::vector<semver::requirement<>>> requirements; // module * 4 + minor
+
+  void operator()(std::string_view module, const semver::version<>& v, std::vector<semver::requirement<>>& out) const {
+    std::size_t id = 0;
+    std::from_chars(module.data() + 1, module.data() + module.size(), id);
+    const auto& list = requirements[id * 4 + static_cast<std::size_t>(v.minor())];
+    out.insert(out.end(), list.begin(), list.end());
+  }
+};
+
+semver::version<> minor_release(std::size_t minor) {
+  semver::version<> result;
+  semver::parse("1." + std::to_string(minor) + ".0", result);
+  return result;
+}
+
+module_graph make_graph(std::size_t modules, std::size_t dependencies, unsigned seed) {
+  std::mt19937 random{ seed };
+  module_graph graph;
+  graph.requirements.resize(modules * 4);
+  for (std::size_t i = 0; i < modules; ++i) {
+    for (std::size_t minor = 0; minor < 4; ++minor) {
+      for (std::size_t k = 0; k < dependencies && i + 1 < modules; ++k) {
+        const std::size_t target = i + 1 + random() % std::min<std::size_t>(modules - i - 1, 256);
+        graph.requirements[i * 4 + minor].push_back({ "m" + std::to_string(target), minor_release(random() % 4) });
+      }
+    }
+  }
+  return graph;
+}
+
+} // namespace
+
+int main() {
+  const std::size_t modules = 100000;
+  const auto graph = make_graph(modules, 4, 42);
+
+  std::vector<semver::requirement<>> roots;
+  for (std::size_t i = 0; i < 64; ++i) {
+    roots.push_back({ "m" + std::to_string(i), minor_release(0) });
+  }
+
+  std::vector<semver::requirement<>> build_list;
+  for (const unsigned threads : { 1U, 0U }) {
+    const std::string name = "mvs_resolve (100k modules, " + (threads == 1 ? std::string{ "1 thread" } : std::string{ "all threads" }) + ")";
+    run(name.c_str(), 5, [&] {
+      build_list = semver::mvs_resolve(roots, graph, threads);
+      do_not_optimize(build_list);
+    });
+  }
+  std::printf("  %zu modules in the build list\n", build_list.size());
+
+  return EXIT_SUCCESS;
+}
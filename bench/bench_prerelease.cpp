@@ -0,0 +1,73 @@
+#include <semver.hpp>
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// The evaluation range_set::contains did before the prerelease gate and the comparators were
+// fused: one pass for the gate, another for the comparators. The gate is spelled out, not
+// match_at_least_one_comparator_with_prerelease, which now skips ranges without prerelease bounds.
+bool contains_two_passes(const semver::range_set<>& range, const semver::version<>& v) {
+  return std::any_of(range.get_ranges().begin(), range.get_ranges().end(), [&](const auto& r) {
+    const bool gate = std::any_of(r.get_comparators().begin(), r.get_comparators().end(), [&](const auto& c) {
+      return !c.get_version().prerelease_tag().empty() && semver::detail::compare_parsed(v, c.get_version(), semver::version_compare_option::exclude_prerelease) == 0;
+    });
+    return gate && std::all_of(r.get_comparators().begin(), r.get_comparators().end(), [&](const auto& c) {
+      return c.contains(v);
+    });
+  });
+}
+
+} // namespace
+
+int main() {
+  constexpr std::size_t iterations = 2000;
+
+  // a nightly channel: every version is a prerelease, most of them of the same few cores
+  std::vector<semver::version<>> nightlies;
+  for (int minor = 0; minor < 4; ++minor) {
+    for (int day = 1; day <= 250; ++day) {
+      semver::version<> v;
+      if (!semver::parse("1." + std::to_string(minor) + ".0-nightly." + std::to_string(20260000 + day), v)) {
+        return EXIT_FAILURE;
+      }
+      nightlies.push_back(v);
+    }
+  }
+
+  constexpr std::pair<std::string_view, std::string_view> ranges[] = {
+    { "one minor", ">=1.2.0-nightly.0 <1.3.0-0" },
+    { "two alternatives", ">=1.0.0-nightly.20260100 <=1.3.0-nightly.20260200 || >=2.0.0-0" },
+    { "releases only", ">1.0.0 <2.0.0" },
+  };
+
+  for (const auto& [label, text] : ranges) {
+    semver::range_set<> range;
+    if (!semver::parse(text, range)) {
+      return EXIT_FAILURE;
+    }
+
+    const std::string fused = "nightlies, " + std::string{ label } + ", fused";
+    run(fused.c_str(), iterations, [&] {
+      for (const auto& v : nightlies) {
+        const bool result = range.contains(v);
+        do_not_optimize(result);
+      }
+    });
+
+    const std::string two_passes = "nightlies, " + std::string{ label } + ", two passes";
+    run(two_passes.c_str(), iterations, [&] {
+      for (const auto& v : nightlies) {
+        const bool result = contains_two_passes(range, v);
+        do_not_optimize(result);
+      }
+    });
+  }
+
+  return EXIT_SUCCESS;
+}
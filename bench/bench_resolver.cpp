@@ -0,0 +1,75 @@
+#include <semver_resolver.hpp>
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A layered monorepo-like graph, generated from a seed: every package has four releases in
+// each of two majors, and each release depends on packages of later layers through caret
+// ranges of its own major. Some releases pin a dependency to one minor and some of the
+// newest ones ask for a major that does not exist, so the solver has to learn conflicts
+// and backjump instead of taking the highest version of everything.
+semver::memory_registry<> make_registry(std::size_t packages, std::size_t dependencies, unsigned seed) {
+  std::mt19937 random{ seed };
+  semver::memory_registry<> registry;
+
+  const auto name = [](std::size_t i) { return "pkg" + std::to_string(i); };
+  const auto range = [](const std::string& text) {
+    semver::range_set<> result;
+    semver::parse(text, result);
+    return result;
+  };
+
+  for (std::size_t i = 0; i < packages; ++i) {
+    for (int major = 1; major <= 2; ++major) {
+      for (int minor = 0; minor < 4; ++minor) {
+        std::vector<semver::dependency<>> requirements;
+        for (std::size_t k = 0; k < dependencies && i + 1 < packages; ++k) {
+          const std::size_t target = i + 1 + random() % std::min<std::size_t>(packages - i - 1, 64);
+          const unsigned kind = random() % 32;
+          std::string text = "^" + std::to_string(major) + ".0.0";
+          if (kind == 0 && minor == 3) {
+            text = "^9.0.0";
+          } else if (kind == 1) {
+            text = "~" + std::to_string(major) + "." + std::to_string(random() % 4) + ".0";
+          }
+          requirements.push_back({ name(target), range(text) });
+        }
+
+        semver::version<> v;
+        semver::parse(std::to_string(major) + "." + std::to_string(minor) + ".0", v);
+        registry.add(name(i), v, std::move(requirements));
+      }
+    }
+  }
+  return registry;
+}
+
+} // namespace
+
+int main() {
+  for (const std::size_t packages : { 1000, 5000 }) {
+    const auto registry = make_registry(packages, 3, 42);
+
+    std::vector<semver::dependency<>> roots;
+    for (std::size_t i = 0; i < packages; i += packages / 10) {
+      semver::range_set<> any;
+      semver::parse("*", any);
+      roots.push_back({ "pkg" + std::to_string(i), any });
+    }
+
+    semver::resolution<> result;
+    const std::string name = "resolve (" + std::to_string(packages) + " packages)";
+    run(name.c_str(), 5, [&] {
+      const bool solved = semver::resolve(registry, roots, result);
+      do_not_optimize(solved);
+    });
+    std::printf("  %zu selected, %zu decisions, %zu conflicts\n", result.packages.size(), result.decisions, result.conflicts);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+#include <semver_io.hpp>
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+int main() {
+  constexpr std::size_t iterations = 20;
+  constexpr std::size_t lines = 100000;
+
+  std::string input;
+  for (std::size_t i = 0; i < lines; ++i) {
+    input += std::to_string(i % 7) + "." + std::to_string(i % 100) + "." + std::to_string(i);
+    input += i % 10 == 0 ? "-rc.1\n" : "\n";
+  }
+
+  run("getline + parse (100k lines)", iterations, [&] {
+    std::istringstream in{ input };
+    std::string line;
+    semver::version<> v;
+    while (std::getline(in, line)) {
+      const auto result = semver::parse(line, v);
+      do_not_optimize(result);
+    }
+    do_not_optimize(v);
+  });
+
+  run("stream_reader (100k lines)", iterations, [&] {
+    std::istringstream in{ input };
+    semver::stream_reader reader{ in };
+    semver::version<> v;
+    // invalid lines are skipped, the end of the input or a read error stops
+    while (reader.read(v) || (reader.error().ec != std::errc{} && reader.error().ec != std::errc::io_error)) {
+    }
+    do_not_optimize(v);
+  });
+
+  run("stream_reader, static_version (100k lines)", iterations, [&] {
+    std::istringstream in{ input };
+    semver::stream_reader reader{ in };
+    semver::static_version<> v;
+    // invalid lines are skipped, the end of the input or a read error stops
+    while (reader.read(v) || (reader.error().ec != std::errc{} && reader.error().ec != std::errc::io_error)) {
+    }
+    do_not_optimize(v);
+  });
+
+  return EXIT_SUCCESS;
+}
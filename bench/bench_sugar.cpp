@@ -0,0 +1,53 @@
+#include <semver.hpp>
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+int main() {
+  constexpr std::size_t iterations = 200000;
+  constexpr std::string_view caret = "^1.2.3";
+  constexpr std::string_view explicit_form = ">=1.2.3 <2.0.0-0";
+
+  run("parse ^1.2.3", iterations, [&] {
+    semver::range_set<> r;
+    const auto result = semver::parse(caret, r);
+    do_not_optimize(result);
+    do_not_optimize(r);
+  });
+
+  run("parse >=1.2.3 <2.0.0-0", iterations, [&] {
+    semver::range_set<> r;
+    const auto result = semver::parse(explicit_form, r);
+    do_not_optimize(result);
+    do_not_optimize(r);
+  });
+
+  semver::range_set<> caret_range;
+  semver::range_set<> explicit_range;
+  if (!semver::parse(caret, caret_range) || !semver::parse(explicit_form, explicit_range)) {
+    return EXIT_FAILURE;
+  }
+
+  std::vector<semver::version<>> versions(3);
+  if (!semver::parse("1.0.0", versions[0]) || !semver::parse("1.9.9", versions[1]) || !semver::parse("2.0.0-rc.1", versions[2])) {
+    return EXIT_FAILURE;
+  }
+
+  run("contains ^1.2.3", iterations, [&] {
+    for (const auto& v : versions) {
+      const bool result = caret_range.contains(v);
+      do_not_optimize(result);
+    }
+  });
+
+  run("contains >=1.2.3 <2.0.0-0", iterations, [&] {
+    for (const auto& v : versions) {
+      const bool result = explicit_range.contains(v);
+      do_not_optimize(result);
+    }
+  });
+
+  return EXIT_SUCCESS;
+}
@@ -46,11 +46,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iosfwd>
+#include <iterator>
 #include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 #if __has_include(<charconv>)
@@ -115,6 +120,41 @@ namespace semver {
       return dest;
     }
 
+    // FNV-1a over the fields that take part in precedence, so equal versions hash equally.
+    class version_hasher {
+    public:
+      SEMVER_CONSTEXPR void add(std::uint64_t n) noexcept {
+        for (int i = 0; i < 8; ++i) {
+          add_byte(static_cast<std::uint8_t>(n >> (i * 8)));
+        }
+      }
+
+      SEMVER_CONSTEXPR void add(std::string_view str) noexcept {
+        for (char c : str) {
+          add_byte(static_cast<std::uint8_t>(c));
+        }
+      }
+
+      SEMVER_CONSTEXPR std::size_t result() const noexcept { return static_cast<std::size_t>(state); }
+
+    private:
+      std::uint64_t state = 14695981039346656037ULL;
+
+      SEMVER_CONSTEXPR void add_byte(std::uint8_t byte) noexcept {
+        state = (state ^ byte) * 1099511628211ULL;
+      }
+    };
+
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR std::size_t hash_version(I1 major, I2 minor, I3 patch, std::string_view prerelease_tag) noexcept {
+      version_hasher hasher;
+      hasher.add(static_cast<std::uint64_t>(major));
+      hasher.add(static_cast<std::uint64_t>(minor));
+      hasher.add(static_cast<std::uint64_t>(patch));
+      hasher.add(prerelease_tag);
+      return hasher.result();
+    }
+
     enum struct prerelease_identifier_type {
       numeric,
       alphanumeric
@@ -127,12 +167,21 @@ namespace semver {
 
     class version_parser;
     class prerelease_comparator;
+    class version_builder;
+    class binary_codec;
+
+    template <typename I1, typename I2, typename I3>
+    class version_automaton;
   }
 
   template <typename I1 = int, typename I2 = int, typename I3 = int>
   class version {
     friend class detail::version_parser;
     friend class detail::prerelease_comparator;
+    friend class detail::version_builder;
+    friend class detail::binary_codec;
+    template <typename, typename, typename>
+    friend class detail::version_automaton;
 
   public:
     SEMVER_CONSTEXPR version() = default; // https://semver.org/#how-should-i-deal-with-revisions-in-the-0yz-initial-development-phase
@@ -152,12 +201,16 @@ namespace semver {
 
     SEMVER_CONSTEXPR std::string to_string() const;
 
+    // Precomputed at parse time, consistent with operator== (build metadata is ignored).
+    SEMVER_CONSTEXPR std::size_t hash() const noexcept { return hash_; }
+
   private:
     I1 major_ = 0;
     I2 minor_ = 1;
     I3 patch_ = 0;
     std::string prerelease_tag_;
     std::string build_metadata_;
+    std::size_t hash_ = detail::hash_version(I1{0}, I2{1}, I3{0}, {});
 
     std::vector<detail::prerelease_identifier> prerelease_identifiers;
 
@@ -175,6 +228,7 @@ namespace semver {
       prerelease_tag_.clear();
       prerelease_identifiers.clear();
       build_metadata_.clear();
+      hash_ = detail::hash_version(major_, minor_, patch_, {});
     }
   };
 
@@ -207,14 +261,27 @@ namespace semver {
 
 #if __has_include(<charconv>)
   struct from_chars_result : std::from_chars_result {
-    [[nodiscard]] SEMVER_CONSTEXPR operator bool() const noexcept { return ec == std::errc{}; }
+    [[nodiscard]] constexpr operator bool() const noexcept { return ec == std::errc{}; }
   };
 #else
   struct from_chars_result {
     const char* ptr;
     std::errc ec;
 
-    [[nodiscard]] SEMVER_CONSTEXPR operator bool() const noexcept { return ec == std::errc{}; }
+    [[nodiscard]] constexpr operator bool() const noexcept { return ec == std::errc{}; }
+  };
+#endif
+
+#if __has_include(<charconv>)
+  struct to_chars_result : std::to_chars_result {
+    [[nodiscard]] constexpr operator bool() const noexcept { return ec == std::errc{}; }
+  };
+#else
+  struct to_chars_result {
+    char* ptr;
+    std::errc ec;
+
+    [[nodiscard]] constexpr operator bool() const noexcept { return ec == std::errc{}; }
   };
 #endif
   
@@ -223,34 +290,39 @@ namespace semver {
     include_prerelease
   };
 
+  enum class sequence_order : std::uint8_t {
+    unsorted,
+    sorted
+  };
+
 namespace detail {
 
-SEMVER_CONSTEXPR from_chars_result success(const char* ptr) noexcept {
+constexpr from_chars_result success(const char* ptr) noexcept {
   return from_chars_result{ ptr, std::errc{} };
 }
 
-SEMVER_CONSTEXPR from_chars_result failure(const char* ptr, std::errc error_code = std::errc::invalid_argument) noexcept {
+constexpr from_chars_result failure(const char* ptr, std::errc error_code = std::errc::invalid_argument) noexcept {
   return from_chars_result{ ptr, error_code };
 }
 
-SEMVER_CONSTEXPR bool is_digit(char c) noexcept {
+constexpr bool is_digit(char c) noexcept {
   return c >= '0' && c <= '9';
 }
 
-SEMVER_CONSTEXPR bool is_letter(char c) noexcept {
+constexpr bool is_letter(char c) noexcept {
   return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
 }
 
-SEMVER_CONSTEXPR std::uint8_t to_digit(char c) noexcept {
+constexpr std::uint8_t to_digit(char c) noexcept {
   return static_cast<std::uint8_t>(c - '0');
 }
 
-SEMVER_CONSTEXPR char to_char(int i) noexcept {
+constexpr char to_char(int i) noexcept {
   return '0' + (char)i;
 }
 
 template<class T, class U>
-SEMVER_CONSTEXPR bool cmp_less(T t, U u) noexcept
+constexpr bool cmp_less(T t, U u) noexcept
 {
   if constexpr (std::is_signed_v<T> == std::is_signed_v<U>)
     return t < u;
@@ -261,26 +333,26 @@ SEMVER_CONSTEXPR bool cmp_less(T t, U u) noexcept
 }
 
 template<class T, class U>
-SEMVER_CONSTEXPR bool cmp_less_equal(T t, U u) noexcept
+constexpr bool cmp_less_equal(T t, U u) noexcept
 {
   return !cmp_less(u, t);
 }
 
 template<class T, class U>
-SEMVER_CONSTEXPR bool cmp_greater_equal(T t, U u) noexcept
+constexpr bool cmp_greater_equal(T t, U u) noexcept
 {
   return !cmp_less(t, u);
 }
 
 template<typename R, typename T>
-SEMVER_CONSTEXPR bool number_in_range(T t) noexcept {
+constexpr bool number_in_range(T t) noexcept {
   return cmp_greater_equal(t, std::numeric_limits<R>::min()) && cmp_less_equal(t, std::numeric_limits<R>::max());
 }
 
-SEMVER_CONSTEXPR int compare(std::string_view lhs, std::string_view rhs) {
+constexpr int compare(std::string_view lhs, std::string_view rhs) {
 #if defined(_MSC_VER) && _MSC_VER < 1920 && !defined(__clang__)
   // https://developercommunity.visualstudio.com/content/problem/360432/vs20178-regression-c-failed-in-test.html
-  // https://developercommunity.visualstudio.com/content/problem/232218/c-SEMVER_CONSTEXPR-string-view.html
+  // https://developercommunity.visualstudio.com/content/problem/232218/c-constexpr-string-view.html
   constexpr bool workaround = true;
 #else
   constexpr bool workaround = false;
@@ -302,7 +374,7 @@ SEMVER_CONSTEXPR int compare(std::string_view lhs, std::string_view rhs) {
   }
 }
 
-SEMVER_CONSTEXPR int compare_numerically(std::string_view lhs, std::string_view rhs) {
+constexpr int compare_numerically(std::string_view lhs, std::string_view rhs) {
   // assume that strings don't have leading zeros (we've already checked it at parsing stage).
 
   if (lhs.size() != rhs.size()) {
@@ -329,7 +401,10 @@ enum class token_type : std::uint8_t {
   letter,
   digit,
   range_operator,
-  logical_or
+  logical_or,
+  wildcard,
+  caret,
+  tilde
 };
 
 enum class range_operator : std::uint8_t {
@@ -455,6 +530,15 @@ class lexer {
     case '=':
       add_token(stream, token_type::range_operator, range_operator::equal);
       break;
+    case '*':
+      add_token(stream, token_type::wildcard);
+      break;
+    case '^':
+      add_token(stream, token_type::caret);
+      break;
+    case '~':
+      add_token(stream, token_type::tilde);
+      break;
     default:
       if (is_digit(c)) {
         add_token(stream, token_type::digit, to_digit(c));
@@ -502,6 +586,110 @@ class lexer {
   SEMVER_CONSTEXPR bool is_eol() const noexcept { return current_pos_ >= text_.size(); }
 };
 
+constexpr int compare_prerelease_identifier(std::string_view lhs, bool lhs_numeric, std::string_view rhs, bool rhs_numeric) {
+  if (lhs_numeric && rhs_numeric) {
+    return compare_numerically(lhs, rhs);
+  } else if (!lhs_numeric && !rhs_numeric) {
+    return detail::compare(lhs, rhs);
+  }
+
+  return lhs_numeric ? -1 : 1;
+}
+
+// Walks the textual form of a version without building tokens or strings.
+class version_scanner {
+ public:
+  constexpr explicit version_scanner(std::string_view text) noexcept : current_{text.data()}, end_{text.data() + text.size()} {}
+
+  template <typename Int>
+  constexpr from_chars_result scan_number(Int& out) noexcept {
+    if (is_eol() || !is_digit(*current_)) {
+      return failure(current_);
+    }
+
+    if (*current_ == '0') {
+      out = 0;
+      return success(++current_);
+    }
+
+    std::uint64_t result = 0;
+    for (; !is_eol() && is_digit(*current_); ++current_) {
+      const std::uint8_t digit = to_digit(*current_);
+      if (result > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+        return failure(current_, std::errc::result_out_of_range);
+      }
+
+      result = result * 10 + digit;
+      if (!detail::number_in_range<Int>(result)) {
+        return failure(current_, std::errc::result_out_of_range);
+      }
+    }
+
+    out = static_cast<Int>(result);
+    return success(current_);
+  }
+
+  constexpr from_chars_result scan_prerelease_identifier(std::string_view& out, bool& numeric) noexcept {
+    const char* first = current_;
+    numeric = true;
+    for (; !is_eol() && is_identifier_symbol(*current_); ++current_) {
+      numeric = numeric && is_digit(*current_);
+    }
+
+    if (first == current_) {
+      return failure(current_);
+    }
+
+    // numerical prerelease identifier doesn't allow leading zero.
+    if (numeric && *first == '0' && current_ - first > 1) {
+      return failure(first);
+    }
+
+    out = std::string_view{first, static_cast<std::size_t>(current_ - first)};
+    return success(current_);
+  }
+
+  constexpr from_chars_result scan_build_identifier() noexcept {
+    const char* first = current_;
+    while (!is_eol() && is_identifier_symbol(*current_)) {
+      ++current_;
+    }
+
+    return first == current_ ? failure(current_) : success(current_);
+  }
+
+  constexpr from_chars_result scan_build_metadata() noexcept {
+    do {
+      if (const auto res = scan_build_identifier(); !res) {
+        return res;
+      }
+    } while (advance_if_match('.'));
+
+    return success(current_);
+  }
+
+  constexpr bool advance_if_match(char c) noexcept {
+    if (is_eol() || *current_ != c) {
+      return false;
+    }
+
+    ++current_;
+    return true;
+  }
+
+  constexpr bool is_eol() const noexcept { return current_ == end_; }
+
+  constexpr const char* position() const noexcept { return current_; }
+
+ private:
+  const char* current_;
+  const char* end_;
+
+  constexpr static bool is_identifier_symbol(char c) noexcept {
+    return c == '-' || is_digit(c) || is_letter(c);
+  }
+};
+
 class prerelease_comparator {
 public:
   template <typename I1, typename I2, typename I3>
@@ -524,13 +712,352 @@ public:
 
 private:
   [[nodiscard]] SEMVER_CONSTEXPR int compare_identifier(const prerelease_identifier& lhs, const prerelease_identifier& rhs) const noexcept {
-    if (lhs.type == prerelease_identifier_type::numeric && rhs.type == prerelease_identifier_type::numeric) {
-      return compare_numerically(lhs.identifier, rhs.identifier);
-    } else if (lhs.type == prerelease_identifier_type::alphanumeric && rhs.type == prerelease_identifier_type::alphanumeric) {
-      return detail::compare(lhs.identifier, rhs.identifier);
+    return compare_prerelease_identifier(lhs.identifier, lhs.type == prerelease_identifier_type::numeric,
+                                         rhs.identifier, rhs.type == prerelease_identifier_type::numeric);
+  }
+};
+
+// A version with trailing parts left out or given as `x`, `X` or `*`, as written in ranges.
+template <typename I1, typename I2, typename I3>
+struct partial_version {
+  I1 major = 0;
+  I2 minor = 0;
+  I3 patch = 0;
+  // how many of major, minor and patch are numbers
+  int components = 0;
+};
+
+enum class range_sugar : std::uint8_t {
+  none,
+  caret,
+  tilde
+};
+
+// One comparator of a desugared range: `op` against the version as written, or against
+// major.minor.patch, with a `-0` prerelease if `zero_prerelease` so no prerelease gets below it.
+template <typename I1, typename I2, typename I3>
+struct desugared_comparator {
+  range_operator op = range_operator::equal;
+  I1 major = 0;
+  I2 minor = 0;
+  I3 patch = 0;
+  bool as_written = false;
+  bool zero_prerelease = false;
+};
+
+// npm range sugar never needs more than two comparators, none meaning any release.
+template <typename I1, typename I2, typename I3>
+struct desugared_range {
+  desugared_comparator<I1, I2, I3> comparators[2];
+  std::size_t size = 0;
+
+  constexpr void add(range_operator op, I1 major, I2 minor, I3 patch, bool zero_prerelease = false) noexcept {
+    comparators[size++] = { op, major, minor, patch, false, zero_prerelease };
+  }
+
+  constexpr void add_as_written(range_operator op) noexcept {
+    comparators[size++] = { op, I1{0}, I2{0}, I3{0}, true, false };
+  }
+
+  // `<0.0.0-0`, which nothing satisfies.
+  constexpr void add_nothing() noexcept {
+    add(range_operator::less, I1{0}, I2{0}, I3{0}, true);
+  }
+
+  // The version right after the last number given, false on overflow.
+  constexpr static bool next(const partial_version<I1, I2, I3>& v, int component, I1& major, I2& minor) noexcept {
+    major = v.major;
+    minor = v.minor;
+    if (component == 1) {
+      major = static_cast<I1>(v.major + 1);
+      minor = I2{0};
+      return v.major < std::numeric_limits<I1>::max();
+    }
+    minor = static_cast<I2>(v.minor + 1);
+    return v.minor < std::numeric_limits<I2>::max();
+  }
+
+  // `<` the version right after the last number given (major or minor), or nothing if there is none.
+  constexpr void add_upper(const partial_version<I1, I2, I3>& v, int component) noexcept {
+    I1 major{};
+    I2 minor{};
+    if (component == 3) {
+      if (v.patch < std::numeric_limits<I3>::max()) {
+        add(range_operator::less, v.major, v.minor, static_cast<I3>(v.patch + 1), true);
+      }
+    } else if (next(v, component, major, minor)) {
+      add(range_operator::less, major, minor, I3{0}, true);
+    }
+  }
+
+  constexpr void add_lower(const partial_version<I1, I2, I3>& v) noexcept {
+    if (v.components == 3) {
+      add_as_written(range_operator::greater_or_equal);
+    } else if (v.components > 0) {
+      add(range_operator::greater_or_equal, v.major, v.minor, I3{0});
+    }
+  }
+};
+
+// `^v`, `~v` and `op v` where `v` may be partial, e.g. `^1.2` is `>=1.2.0 <2.0.0-0`,
+// `~1.2.3` is `>=1.2.3 <1.3.0-0`, `1.x` is `>=1.0.0 <2.0.0-0` and `<=1.2` is `<1.3.0-0`.
+template <typename I1, typename I2, typename I3>
+constexpr desugared_range<I1, I2, I3> desugar(range_sugar sugar, range_operator op, const partial_version<I1, I2, I3>& v) noexcept {
+  desugared_range<I1, I2, I3> result;
+  if (v.components == 0) {
+    if (sugar == range_sugar::none && (op == range_operator::less || op == range_operator::greater)) {
+      result.add_nothing();
+    }
+    return result;
+  }
+
+  switch (sugar) {
+  case range_sugar::caret:
+    result.add_lower(v);
+    // the leftmost non-zero number given may not change
+    if (v.major != 0 || v.components == 1) {
+      result.add_upper(v, 1);
+    } else if (v.minor != 0 || v.components == 2) {
+      result.add_upper(v, 2);
+    } else {
+      result.add_upper(v, 3);
+    }
+    return result;
+  case range_sugar::tilde:
+    result.add_lower(v);
+    result.add_upper(v, v.components == 1 ? 1 : 2);
+    return result;
+  case range_sugar::none:
+    break;
+  }
+
+  if (v.components == 3) {
+    result.add_as_written(op);
+    return result;
+  }
+
+  I1 major{};
+  I2 minor{};
+  switch (op) {
+  case range_operator::equal:
+    result.add_lower(v);
+    result.add_upper(v, v.components);
+    break;
+  case range_operator::greater_or_equal:
+    result.add_lower(v);
+    break;
+  case range_operator::greater:
+    if (desugared_range<I1, I2, I3>::next(v, v.components, major, minor)) {
+      result.add(range_operator::greater_or_equal, major, minor, I3{0});
+    } else {
+      result.add_nothing();
+    }
+    break;
+  case range_operator::less:
+    result.add(range_operator::less, v.major, v.minor, I3{0}, true);
+    break;
+  case range_operator::less_or_equal:
+    result.add_upper(v, v.components);
+    break;
+  }
+  return result;
+}
+
+// `a - b`, an inclusive range of possibly partial versions.
+template <typename I1, typename I2, typename I3>
+constexpr desugared_range<I1, I2, I3> desugar_hyphen(const partial_version<I1, I2, I3>& lower, const partial_version<I1, I2, I3>& upper) noexcept {
+  desugared_range<I1, I2, I3> result;
+  result.add_lower(lower);
+  if (upper.components == 3) {
+    result.add_as_written(range_operator::less_or_equal);
+  } else if (upper.components > 0) {
+    result.add_upper(upper, upper.components);
+  }
+  return result;
+}
+
+// A version as written in a range: the numbers given and, for a full version, its tags as views of the text.
+template <typename I1, typename I2, typename I3>
+struct written_version {
+  partial_version<I1, I2, I3> partial;
+  std::string_view prerelease_tag;
+  std::string_view build_metadata;
+};
+
+// The range grammar, char by char, shared by range_set and static_range_set: ranges joined by `||`,
+// each of comparators joined by spaces. Sugar is lowered right away, so `^1.2.3` costs no more than
+// `>=1.2.3 <2.0.0-0` to evaluate. `out.add(desugared, lower, upper)` takes each comparator and
+// `out.next_range()` closes each range, both returning a std::errc.
+template <typename I1, typename I2, typename I3>
+class range_scanner {
+public:
+  constexpr explicit range_scanner(std::string_view text) noexcept : text_{text} {}
+
+  template <typename Out>
+  constexpr from_chars_result parse(Out& out) noexcept {
+    do {
+      do {
+        skip_whitespaces();
+        if (const auto res = parse_comparator(out); !res) {
+          return res;
+        }
+        skip_whitespaces();
+      } while (starts_comparator());
+
+      if (const std::errc ec = out.next_range(); ec != std::errc{}) {
+        return failure(current(), ec);
+      }
+    } while (advance_if_match("||"));
+
+    return success(current());
+  }
+
+private:
+  std::string_view text_;
+  std::size_t pos_ = 0;
+
+  constexpr const char* current() const noexcept { return text_.data() + pos_; }
+
+  constexpr char peek(std::size_t k = 0) const noexcept { return pos_ + k < text_.size() ? text_[pos_ + k] : '\0'; }
+
+  constexpr bool advance_if_match(std::string_view str) noexcept {
+    if (text_.substr(pos_, str.size()) != str) {
+      return false;
+    }
+    pos_ += str.size();
+    return true;
+  }
+
+  constexpr void skip_whitespaces() noexcept {
+    while (peek() == ' ') {
+      ++pos_;
+    }
+  }
+
+  constexpr static bool is_wildcard(char c) noexcept { return c == 'x' || c == 'X' || c == '*'; }
+
+  constexpr bool starts_comparator() const noexcept {
+    const char c = peek();
+    return c == '<' || c == '>' || c == '=' || c == '^' || c == '~' || is_digit(c) || is_wildcard(c);
+  }
+
+  template <typename Out>
+  constexpr from_chars_result parse_comparator(Out& out) noexcept {
+    range_operator op = range_operator::equal;
+    range_sugar sugar = range_sugar::none;
+    bool has_operator = true;
+    if (advance_if_match("<=")) {
+      op = range_operator::less_or_equal;
+    } else if (advance_if_match(">=")) {
+      op = range_operator::greater_or_equal;
+    } else if (advance_if_match("<")) {
+      op = range_operator::less;
+    } else if (advance_if_match(">")) {
+      op = range_operator::greater;
+    } else if (advance_if_match("=")) {
+      op = range_operator::equal;
+    } else {
+      has_operator = false;
+      if (advance_if_match("^")) {
+        sugar = range_sugar::caret;
+      } else if (advance_if_match("~")) {
+        sugar = range_sugar::tilde;
+      }
+    }
+
+    skip_whitespaces();
+
+    written_version<I1, I2, I3> lower;
+    if (const auto res = parse_partial(lower); !res) {
+      return res;
+    }
+
+    // ` - ` between two versions, where a hyphen without spaces would start a prerelease tag
+    std::size_t k = 0;
+    while (peek(k) == ' ') {
+      ++k;
+    }
+
+    std::errc ec{};
+    if (sugar == range_sugar::none && !has_operator && k > 0 && peek(k) == '-' && peek(k + 1) == ' ') {
+      pos_ += k + 1;
+      skip_whitespaces();
+
+      written_version<I1, I2, I3> upper;
+      if (const auto res = parse_partial(upper); !res) {
+        return res;
+      }
+      ec = out.add(desugar_hyphen(lower.partial, upper.partial), lower, upper);
+    } else {
+      ec = out.add(desugar(sugar, op, lower.partial), lower, lower);
+    }
+    return ec == std::errc{} ? success(current()) : failure(current(), ec);
+  }
+
+  // A version which may leave out trailing parts or give them as `x`, `X` or `*`.
+  // Only a version with all three numbers may have a prerelease tag or build metadata.
+  constexpr from_chars_result parse_partial(written_version<I1, I2, I3>& out) noexcept {
+    out = {};
+    bool wildcard = false;
+    for (int i = 0; i < 3; ++i) {
+      if (i > 0) {
+        if (peek() != '.') {
+          break;
+        }
+        ++pos_;
+      }
+
+      if (is_wildcard(peek())) {
+        ++pos_;
+        wildcard = true;
+        continue;
+      }
+
+      if (wildcard) {
+        return failure(current());
+      }
+
+      version_scanner scanner{ text_.substr(pos_) };
+      const from_chars_result result = i == 0 ? scanner.scan_number(out.partial.major) : i == 1 ? scanner.scan_number(out.partial.minor) : scanner.scan_number(out.partial.patch);
+      if (!result) {
+        return result;
+      }
+      pos_ = static_cast<std::size_t>(scanner.position() - text_.data());
+      ++out.partial.components;
+    }
+
+    // a number may not run on into another, e.g. a leading zero in `01.2.3` or `1.01`
+    if (is_digit(peek()) || is_letter(peek()) || peek() == '*') {
+      return failure(current());
+    }
+
+    if (out.partial.components < 3) {
+      return success(current());
+    }
+
+    version_scanner scanner{ text_.substr(pos_) };
+    if (scanner.advance_if_match('-')) {
+      const char* first = scanner.position();
+      do {
+        std::string_view identifier;
+        bool numeric = false;
+        if (const auto res = scanner.scan_prerelease_identifier(identifier, numeric); !res) {
+          return res;
+        }
+      } while (scanner.advance_if_match('.'));
+      out.prerelease_tag = std::string_view{first, static_cast<std::size_t>(scanner.position() - first)};
     }
 
-    return lhs.type == prerelease_identifier_type::alphanumeric ? 1 : -1;
+    if (scanner.advance_if_match('+')) {
+      const char* first = scanner.position();
+      if (const auto res = scanner.scan_build_metadata(); !res) {
+        return res;
+      }
+      out.build_metadata = std::string_view{first, static_cast<std::size_t>(scanner.position() - first)};
+    }
+
+    pos_ = static_cast<std::size_t>(scanner.position() - text_.data());
+    return success(current());
   }
 };
 
@@ -580,10 +1107,11 @@ class version_parser {
       }
     }
 
+    out.hash_ = hash_version(out.major_, out.minor_, out.patch_, out.prerelease_tag_);
+
     return result;
   }
 
-
  private:
   token_stream& stream;
 
@@ -824,228 +1352,3488 @@ SEMVER_CONSTEXPR from_chars_result parse(std::string_view str, version<I1, I2, I
   return success(token_stream.previous().lexeme);
 }
 
-} // namespace semver::detail
+SEMVER_CONSTEXPR from_chars_result compare(std::string_view lhs, std::string_view rhs, int& out) noexcept {
+  version_scanner lhs_scanner{ lhs };
+  version_scanner rhs_scanner{ rhs };
 
-template <typename I1, typename I2, typename I3>
-[[nodiscard]] SEMVER_CONSTEXPR bool operator==(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
-  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) == 0;
-}
+  // Once the order is known the rest of both strings is only validated.
+  int result = 0;
 
-template <typename I1, typename I2, typename I3>
-[[nodiscard]] SEMVER_CONSTEXPR bool operator!=(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
-  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) != 0;
-}
+  for (int i = 0; i < 3; ++i) {
+    if (i != 0) {
+      if (!lhs_scanner.advance_if_match('.')) {
+        return failure(lhs_scanner.position());
+      }
 
-template <typename I1, typename I2, typename I3>
-[[nodiscard]] SEMVER_CONSTEXPR bool operator>(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
-  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) > 0;
-}
+      if (!rhs_scanner.advance_if_match('.')) {
+        return failure(rhs_scanner.position());
+      }
+    }
 
-template <typename I1, typename I2, typename I3>
-[[nodiscard]] SEMVER_CONSTEXPR bool operator>=(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
-  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) >= 0;
-}
+    int lhs_number = 0;
+    if (const auto res = lhs_scanner.scan_number(lhs_number); !res) {
+      return res;
+    }
 
-template <typename I1, typename I2, typename I3>
-[[nodiscard]] SEMVER_CONSTEXPR bool operator<(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
-  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) < 0;
-}
+    int rhs_number = 0;
+    if (const auto res = rhs_scanner.scan_number(rhs_number); !res) {
+      return res;
+    }
 
-template <typename I1, typename I2, typename I3>
-[[nodiscard]] SEMVER_CONSTEXPR bool operator<=(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
-  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) <= 0;
-}
+    if (result == 0) {
+      result = (lhs_number > rhs_number) - (lhs_number < rhs_number);
+    }
+  }
 
-#if __cpp_impl_three_way_comparison >= 201907L
-template <typename I1, typename I2, typename I3>
-[[nodiscard]] SEMVER_CONSTEXPR std::strong_ordering operator<=>(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) {
-  int compare = detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease);
-  if (compare == 0)
-    return std::strong_ordering::equal;
-  if (compare > 0)
-    return std::strong_ordering::greater;
-  return std::strong_ordering::less;
-}
-#endif
+  bool lhs_has_identifier = lhs_scanner.advance_if_match('-');
+  bool rhs_has_identifier = rhs_scanner.advance_if_match('-');
 
-template<typename I1, typename I2, typename I3>
-SEMVER_CONSTEXPR from_chars_result parse(std::string_view str, version<I1, I2, I3>& output) {
-  return detail::parse(str, output);
-}
+  if (result == 0 && lhs_has_identifier != rhs_has_identifier) {
+    result = lhs_has_identifier ? -1 : 1;
+  }
 
-SEMVER_CONSTEXPR bool valid(std::string_view str) {
-  version v{};
+  while (lhs_has_identifier || rhs_has_identifier) {
+    std::string_view lhs_identifier;
+    bool lhs_numeric = false;
+    const bool lhs_scanned = lhs_has_identifier;
+    if (lhs_scanned) {
+      if (const auto res = lhs_scanner.scan_prerelease_identifier(lhs_identifier, lhs_numeric); !res) {
+        return res;
+      }
+      lhs_has_identifier = lhs_scanner.advance_if_match('.');
+    }
+
+    std::string_view rhs_identifier;
+    bool rhs_numeric = false;
+    const bool rhs_scanned = rhs_has_identifier;
+    if (rhs_scanned) {
+      if (const auto res = rhs_scanner.scan_prerelease_identifier(rhs_identifier, rhs_numeric); !res) {
+        return res;
+      }
+      rhs_has_identifier = rhs_scanner.advance_if_match('.');
+    }
+
+    if (result == 0) {
+      if (lhs_scanned && rhs_scanned) {
+        const int identifier_result = compare_prerelease_identifier(lhs_identifier, lhs_numeric, rhs_identifier, rhs_numeric);
+        result = (identifier_result > 0) - (identifier_result < 0);
+      } else {
+        // A larger set of prerelease fields has a higher precedence than a smaller set.
+        result = lhs_scanned ? 1 : -1;
+      }
+    }
+  }
+
+  if (lhs_scanner.advance_if_match('+')) {
+    if (const auto res = lhs_scanner.scan_build_metadata(); !res) {
+      return res;
+    }
+  }
+
+  if (rhs_scanner.advance_if_match('+')) {
+    if (const auto res = rhs_scanner.scan_build_metadata(); !res) {
+      return res;
+    }
+  }
+
+  if (!lhs_scanner.is_eol()) {
+    return failure(lhs_scanner.position());
+  }
+
+  if (!rhs_scanner.is_eol()) {
+    return failure(rhs_scanner.position());
+  }
+
+  out = result;
+  return success(lhs_scanner.position());
+}
+
+// Validates a version string and extracts the fields that take part in precedence, without allocating.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR from_chars_result scan(std::string_view str, I1& major, I2& minor, I3& patch, std::string_view& prerelease_tag) noexcept {
+  version_scanner scanner{ str };
+
+  if (const auto res = scanner.scan_number(major); !res) {
+    return res;
+  }
+
+  if (!scanner.advance_if_match('.')) {
+    return failure(scanner.position());
+  }
+
+  if (const auto res = scanner.scan_number(minor); !res) {
+    return res;
+  }
+
+  if (!scanner.advance_if_match('.')) {
+    return failure(scanner.position());
+  }
+
+  if (const auto res = scanner.scan_number(patch); !res) {
+    return res;
+  }
+
+  prerelease_tag = {};
+  if (scanner.advance_if_match('-')) {
+    const char* first = scanner.position();
+    do {
+      std::string_view identifier;
+      bool numeric = false;
+      if (const auto res = scanner.scan_prerelease_identifier(identifier, numeric); !res) {
+        return res;
+      }
+    } while (scanner.advance_if_match('.'));
+
+    prerelease_tag = std::string_view{first, static_cast<std::size_t>(scanner.position() - first)};
+  }
+
+  if (scanner.advance_if_match('+')) {
+    if (const auto res = scanner.scan_build_metadata(); !res) {
+      return res;
+    }
+  }
+
+  if (!scanner.is_eol()) {
+    return failure(scanner.position());
+  }
+
+  return success(scanner.position());
+}
+
+// Builds versions that never went through the parser, e.g. bounds synthesized by range algebra.
+class version_builder {
+public:
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR static version<I1, I2, I3> make(I1 major, I2 minor, I3 patch, std::string_view prerelease_tag = {}, std::string_view build_metadata = {}) {
+    version<I1, I2, I3> result;
+    result.major_ = major;
+    result.minor_ = minor;
+    result.patch_ = patch;
+    result.prerelease_tag_.assign(prerelease_tag.data(), prerelease_tag.size());
+    result.build_metadata_.assign(build_metadata.data(), build_metadata.size());
+
+    std::size_t first = 0;
+    while (first < prerelease_tag.size()) {
+      std::size_t last = prerelease_tag.find('.', first);
+      if (last == std::string_view::npos) {
+        last = prerelease_tag.size();
+      }
+
+      const std::string_view identifier = prerelease_tag.substr(first, last - first);
+      const bool numeric = std::all_of(identifier.begin(), identifier.end(), [](char c) { return is_digit(c); });
+      result.prerelease_identifiers.push_back({ numeric ? prerelease_identifier_type::numeric : prerelease_identifier_type::alphanumeric, std::string{identifier} });
+      first = last + 1;
+    }
+
+    result.hash_ = hash_version(major, minor, patch, prerelease_tag);
+    return result;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR static version<I1, I2, I3> core(const version<I1, I2, I3>& v) {
+    return make(v.major(), v.minor(), v.patch());
+  }
+
+  // The version right after `v` in precedence order; false if `v` is the greatest representable one.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR static bool successor(const version<I1, I2, I3>& v, version<I1, I2, I3>& out) {
+    if (!v.prerelease_tag().empty()) {
+      out = make(v.major(), v.minor(), v.patch(), v.prerelease_tag() + ".0");
+    } else if (v.patch() < std::numeric_limits<I3>::max()) {
+      out = make(v.major(), v.minor(), static_cast<I3>(v.patch() + 1), "0");
+    } else if (v.minor() < std::numeric_limits<I2>::max()) {
+      out = make(v.major(), static_cast<I2>(v.minor() + 1), I3{0}, "0");
+    } else if (v.major() < std::numeric_limits<I1>::max()) {
+      out = make(static_cast<I1>(v.major() + 1), I2{0}, I3{0}, "0");
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // The version whose successor is `v`, if it has an obvious one.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR static bool predecessor(const version<I1, I2, I3>& v, version<I1, I2, I3>& out) {
+    const std::string_view tag = v.prerelease_tag();
+    if (tag.size() > 2 && tag.substr(tag.size() - 2) == ".0") {
+      out = make(v.major(), v.minor(), v.patch(), tag.substr(0, tag.size() - 2));
+      return true;
+    }
+
+    if (tag == "0" && v.patch() > 0) {
+      out = make(v.major(), v.minor(), static_cast<I3>(v.patch() - 1));
+      return true;
+    }
+
+    return false;
+  }
+};
+
+} // namespace semver::detail
+
+template <typename I1, typename I2, typename I3>
+[[nodiscard]] SEMVER_CONSTEXPR bool operator==(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
+  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) == 0;
+}
+
+template <typename I1, typename I2, typename I3>
+[[nodiscard]] SEMVER_CONSTEXPR bool operator!=(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
+  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) != 0;
+}
+
+template <typename I1, typename I2, typename I3>
+[[nodiscard]] SEMVER_CONSTEXPR bool operator>(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
+  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) > 0;
+}
+
+template <typename I1, typename I2, typename I3>
+[[nodiscard]] SEMVER_CONSTEXPR bool operator>=(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
+  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) >= 0;
+}
+
+template <typename I1, typename I2, typename I3>
+[[nodiscard]] SEMVER_CONSTEXPR bool operator<(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
+  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) < 0;
+}
+
+template <typename I1, typename I2, typename I3>
+[[nodiscard]] SEMVER_CONSTEXPR bool operator<=(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
+  return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) <= 0;
+}
+
+#if __cpp_impl_three_way_comparison >= 201907L
+template <typename I1, typename I2, typename I3>
+[[nodiscard]] SEMVER_CONSTEXPR std::strong_ordering operator<=>(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) {
+  int compare = detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease);
+  if (compare == 0)
+    return std::strong_ordering::equal;
+  if (compare > 0)
+    return std::strong_ordering::greater;
+  return std::strong_ordering::less;
+}
+#endif
+
+template<typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR from_chars_result parse(std::string_view str, version<I1, I2, I3>& output) {
+  return detail::parse(str, output);
+}
+
+SEMVER_CONSTEXPR bool valid(std::string_view str) {
+  version v{};
   return detail::parse(str, v);
 }
 
+// Compares two version strings by precedence without parsing them into version objects.
+// On success `out` is -1, 0 or 1; on failure `ptr` points to the offending symbol of the invalid string.
+SEMVER_CONSTEXPR from_chars_result compare(std::string_view lhs, std::string_view rhs, int& out) noexcept {
+  return detail::compare(lhs, rhs, out);
+}
+
+namespace detail {
+  // Rounds a version of `size` bytes up to 8 or 16 so it moves as a single aligned word.
+  constexpr std::size_t core_version_alignment(std::size_t size) noexcept {
+    return size <= 8 ? 8 : size <= 16 ? 16 : alignof(std::uint64_t);
+  }
+} // namespace semver::detail
+
+// A release version without prerelease tag or build metadata: three integers, trivially copyable.
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+class alignas(detail::core_version_alignment(sizeof(I1) + sizeof(I2) + sizeof(I3))) core_version {
+public:
+  constexpr core_version() = default;
+
+  constexpr core_version(I1 major, I2 minor, I3 patch) noexcept : major_{major}, minor_{minor}, patch_{patch} {}
+
+  constexpr I1 major() const noexcept { return major_; }
+  constexpr I2 minor() const noexcept { return minor_; }
+  constexpr I3 patch() const noexcept { return patch_; }
+
+  // Same value as version::hash() of the equal version.
+  SEMVER_CONSTEXPR std::size_t hash() const noexcept { return detail::hash_version(major_, minor_, patch_, {}); }
+
+  [[nodiscard]] friend constexpr bool operator==(const core_version& lhs, const core_version& rhs) noexcept { return compare(lhs, rhs) == 0; }
+  [[nodiscard]] friend constexpr bool operator!=(const core_version& lhs, const core_version& rhs) noexcept { return compare(lhs, rhs) != 0; }
+  [[nodiscard]] friend constexpr bool operator<(const core_version& lhs, const core_version& rhs) noexcept { return compare(lhs, rhs) < 0; }
+  [[nodiscard]] friend constexpr bool operator<=(const core_version& lhs, const core_version& rhs) noexcept { return compare(lhs, rhs) <= 0; }
+  [[nodiscard]] friend constexpr bool operator>(const core_version& lhs, const core_version& rhs) noexcept { return compare(lhs, rhs) > 0; }
+  [[nodiscard]] friend constexpr bool operator>=(const core_version& lhs, const core_version& rhs) noexcept { return compare(lhs, rhs) >= 0; }
+
+private:
+  I1 major_ = 0;
+  I2 minor_ = 1;
+  I3 patch_ = 0;
+
+  constexpr static int compare(const core_version& lhs, const core_version& rhs) noexcept;
+};
+
+namespace detail {
+  template <typename I1, typename I2, typename I3>
+  constexpr int compare_core(const core_version<I1, I2, I3>& lhs, I1 major, I2 minor, I3 patch) noexcept {
+    if (lhs.major() != major) {
+      return lhs.major() < major ? -1 : 1;
+    }
+    if (lhs.minor() != minor) {
+      return lhs.minor() < minor ? -1 : 1;
+    }
+    if (lhs.patch() != patch) {
+      return lhs.patch() < patch ? -1 : 1;
+    }
+    return 0;
+  }
+} // namespace semver::detail
+
+template <typename I1, typename I2, typename I3>
+constexpr int core_version<I1, I2, I3>::compare(const core_version& lhs, const core_version& rhs) noexcept {
+  return detail::compare_core(lhs, rhs.major_, rhs.minor_, rhs.patch_);
+}
+
+// Build metadata is accepted and dropped, a prerelease tag is an error.
+template <typename I1, typename I2, typename I3>
+constexpr from_chars_result parse(std::string_view str, core_version<I1, I2, I3>& out) noexcept {
+  detail::version_scanner scanner{ str };
+  I1 major = 0;
+  I2 minor = 0;
+  I3 patch = 0;
+
+  if (const auto res = scanner.scan_number(major); !res) {
+    return res;
+  }
+  if (!scanner.advance_if_match('.')) {
+    return detail::failure(scanner.position());
+  }
+  if (const auto res = scanner.scan_number(minor); !res) {
+    return res;
+  }
+  if (!scanner.advance_if_match('.')) {
+    return detail::failure(scanner.position());
+  }
+  if (const auto res = scanner.scan_number(patch); !res) {
+    return res;
+  }
+  if (scanner.advance_if_match('+')) {
+    if (const auto res = scanner.scan_build_metadata(); !res) {
+      return res;
+    }
+  }
+  if (!scanner.is_eol()) {
+    return detail::failure(scanner.position());
+  }
+
+  out = core_version<I1, I2, I3>{ major, minor, patch };
+  return detail::success(scanner.position());
+}
+
+// False if `v` has a prerelease tag; build metadata is dropped.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR bool to_core_version(const version<I1, I2, I3>& v, core_version<I1, I2, I3>& out) noexcept {
+  if (!v.prerelease_tag().empty()) {
+    return false;
+  }
+
+  out = core_version<I1, I2, I3>{ v.major(), v.minor(), v.patch() };
+  return true;
+}
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR version<I1, I2, I3> to_version(const core_version<I1, I2, I3>& v) {
+  return detail::version_builder::make(v.major(), v.minor(), v.patch());
+}
+
+// Deduplicates versions and hands out dense ids, 32-bit by default.
+// After sort() ids follow precedence order, so comparing two ids is comparing the versions.
+// A pool holds at most max_size() versions, interning a new one past that fails with std::errc::value_too_large.
+template <typename I1 = int, typename I2 = int, typename I3 = int, typename Id = std::uint32_t>
+class version_pool {
+public:
+  static_assert(std::is_unsigned_v<Id>, "version_pool ids must be unsigned");
+
+  using id_type = Id;
+
+  static constexpr std::size_t max_size() noexcept { return empty_slot; }
+
+  SEMVER_CONSTEXPR from_chars_result intern(std::string_view str, id_type& out) {
+    const id_type* slot = nullptr;
+    if (const auto res = find_slot(str, slot); !res) {
+      return res;
+    } else if (slot != nullptr && *slot != empty_slot) {
+      out = *slot;
+      return res;
+    }
+
+    if (versions_.size() >= max_size()) {
+      return detail::failure(str.data(), std::errc::value_too_large);
+    }
+
+    version<I1, I2, I3> v;
+    const auto res = semver::parse(str, v);
+    if (res) {
+      out = insert(std::move(v));
+    }
+    return res;
+  }
+
+  // `ptr` is null, there is no text to point into.
+  SEMVER_CONSTEXPR from_chars_result intern(const version<I1, I2, I3>& v, id_type& out) {
+    if (!slots_.empty()) {
+      if (const id_type* slot = find_slot(v.hash(), v.major(), v.minor(), v.patch(), v.prerelease_tag()); *slot != empty_slot) {
+        out = *slot;
+        return detail::success(nullptr);
+      }
+    }
+
+    if (versions_.size() >= max_size()) {
+      return detail::failure(nullptr, std::errc::value_too_large);
+    }
+
+    out = insert(v);
+    return detail::success(nullptr);
+  }
+
+  // Never allocates. Returns false if the string is not a valid version or it is not in the pool.
+  SEMVER_CONSTEXPR bool find(std::string_view str, id_type& out) const noexcept {
+    const id_type* slot = nullptr;
+    if (!find_slot(str, slot) || slot == nullptr || *slot == empty_slot) {
+      return false;
+    }
+
+    out = *slot;
+    return true;
+  }
+
+  SEMVER_CONSTEXPR const version<I1, I2, I3>& operator[](id_type id) const noexcept { return versions_[id]; }
+
+  SEMVER_CONSTEXPR std::size_t size() const noexcept { return versions_.size(); }
+
+  SEMVER_CONSTEXPR bool empty() const noexcept { return versions_.empty(); }
+
+  SEMVER_CONSTEXPR bool sorted() const noexcept { return sorted_; }
+
+  // Renumbers ids in precedence order. Returns the new id for every old id.
+  SEMVER_CONSTEXPR std::vector<id_type> sort() {
+    std::vector<id_type> order(versions_.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      order[i] = static_cast<id_type>(i);
+    }
+
+    std::sort(order.begin(), order.end(), [&](id_type lhs, id_type rhs) {
+      return detail::compare_parsed(versions_[lhs], versions_[rhs], version_compare_option::include_prerelease) < 0;
+    });
+
+    std::vector<id_type> mapping(versions_.size());
+    std::vector<version<I1, I2, I3>> versions;
+    versions.reserve(versions_.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      mapping[order[i]] = static_cast<id_type>(i);
+      versions.push_back(std::move(versions_[order[i]]));
+    }
+
+    versions_ = std::move(versions);
+    rehash(slots_.size());
+    sorted_ = true;
+
+    return mapping;
+  }
+
+private:
+  static constexpr id_type empty_slot = std::numeric_limits<id_type>::max();
+
+  std::vector<version<I1, I2, I3>> versions_;
+  std::vector<id_type> slots_;
+  bool sorted_ = true;
+
+  SEMVER_CONSTEXPR from_chars_result find_slot(std::string_view str, const id_type*& slot) const noexcept {
+    I1 major = 0;
+    I2 minor = 0;
+    I3 patch = 0;
+    std::string_view prerelease_tag;
+    const auto res = detail::scan(str, major, minor, patch, prerelease_tag);
+    if (res && !slots_.empty()) {
+      slot = find_slot(detail::hash_version(major, minor, patch, prerelease_tag), major, minor, patch, prerelease_tag);
+    }
+    return res;
+  }
+
+  SEMVER_CONSTEXPR const id_type* find_slot(std::size_t hash, I1 major, I2 minor, I3 patch, std::string_view prerelease_tag) const noexcept {
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+      const id_type id = slots_[i];
+      if (id == empty_slot) {
+        return &slots_[i];
+      }
+
+      const auto& v = versions_[id];
+      if (v.hash() == hash && v.major() == major && v.minor() == minor && v.patch() == patch && v.prerelease_tag() == prerelease_tag) {
+        return &slots_[i];
+      }
+    }
+  }
+
+  // Callers check max_size() first, so the new id is never empty_slot.
+  SEMVER_CONSTEXPR id_type insert(version<I1, I2, I3> v) {
+    if ((versions_.size() + 1) * 2 > slots_.size()) {
+      rehash(slots_.empty() ? 16 : slots_.size() * 2);
+    }
+
+    if (sorted_ && !versions_.empty()) {
+      sorted_ = detail::compare_parsed(versions_.back(), v, version_compare_option::include_prerelease) < 0;
+    }
+
+    const auto id = static_cast<id_type>(versions_.size());
+    versions_.push_back(std::move(v));
+    place(id);
+    return id;
+  }
+
+  SEMVER_CONSTEXPR void rehash(std::size_t count) {
+    slots_.assign(count, empty_slot);
+    for (std::size_t id = 0; id < versions_.size(); ++id) {
+      place(static_cast<id_type>(id));
+    }
+  }
+
+  SEMVER_CONSTEXPR void place(id_type id) noexcept {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t i = versions_[id].hash() & mask;
+    while (slots_[i] != empty_slot) {
+      i = (i + 1) & mask;
+    }
+    slots_[i] = id;
+  }
+};
+
+namespace detail {
+  // Whether a version comparing to a bound as `result` satisfies `op` against it.
+  constexpr bool accepts(range_operator op, int result) noexcept {
+    switch (op) {
+    case range_operator::less:
+      return result < 0;
+    case range_operator::less_or_equal:
+      return result <= 0;
+    case range_operator::greater:
+      return result > 0;
+    case range_operator::greater_or_equal:
+      return result >= 0;
+    case range_operator::equal:
+      return result == 0;
+    }
+    return false;
+  }
+
+  // Whether the comparators `[first, last)` of one range all accept `v`, shared by range and static_range_set.
+  // Each comparator has get_version(), compare(v, option) and accepts(result). Under exclude_prerelease a
+  // prerelease also needs a prerelease bound of the same numbers; that gate and the comparators are checked
+  // in one pass, the numbers of each bound compared once.
+  template <typename It, typename V>
+  constexpr bool comparators_contain(It first, It last, const V& v, version_compare_option option) noexcept {
+    if (option == version_compare_option::include_prerelease || v.prerelease_tag().empty()) {
+      for (; first != last; ++first) {
+        if (!first->accepts(first->compare(v, version_compare_option::include_prerelease))) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool gate = false;
+    for (; first != last; ++first) {
+      int result = first->compare(v, version_compare_option::exclude_prerelease);
+      if (result == 0 && first->get_version().prerelease_tag().empty()) {
+        result = -1;
+      } else if (result == 0) {
+        gate = true;
+        result = first->compare(v, version_compare_option::include_prerelease);
+      }
+      if (!first->accepts(result)) {
+        return false;
+      }
+    }
+    return gate;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  class range_comparator {
+  public:
+    SEMVER_CONSTEXPR range_comparator(const version<I1, I2, I3>& v, range_operator op) noexcept : v(v), op(op) {}
+
+    SEMVER_CONSTEXPR bool contains(const version<I1, I2, I3>& other) const noexcept {
+      return accepts(compare(other, version_compare_option::include_prerelease));
+    }
+
+    // The order of `other` against the bound.
+    SEMVER_CONSTEXPR int compare(const version<I1, I2, I3>& other, version_compare_option option) const noexcept {
+      return detail::compare_parsed(other, v, option);
+    }
+
+    SEMVER_CONSTEXPR bool contains(const core_version<I1, I2, I3>& other) const noexcept {
+      // a release is greater than any prerelease of the same numbers
+      int result = detail::compare_core(other, v.major(), v.minor(), v.patch());
+      if (result == 0 && !v.prerelease_tag().empty()) {
+        result = 1;
+      }
+
+      return accepts(result);
+    }
+
+    // Whether a version comparing to the bound as `result` satisfies the operator.
+    SEMVER_CONSTEXPR bool accepts(int result) const noexcept { return detail::accepts(op, result); }
+
+    SEMVER_CONSTEXPR const version<I1, I2, I3>& get_version() const noexcept { return v; }
+
+    SEMVER_CONSTEXPR range_operator get_operator() const noexcept { return op; }
+
+  private:
+    version<I1, I2, I3> v;
+    range_operator op;
+  };
+
+  // One side of an interval of versions, `v == nullptr` means unbounded.
+  template <typename I1, typename I2, typename I3>
+  struct range_bound {
+    const version<I1, I2, I3>* v = nullptr;
+    bool inclusive = false;
+  };
+
+  // The comparators of a range intersected into a single interval ordered by precedence.
+  template <typename I1, typename I2, typename I3>
+  struct range_interval {
+    range_bound<I1, I2, I3> lower;
+    range_bound<I1, I2, I3> upper;
+
+    SEMVER_CONSTEXPR void tighten_lower(const version<I1, I2, I3>& v, bool inclusive) noexcept {
+      const int result = lower.v == nullptr ? 1 : detail::compare_parsed(v, *lower.v, version_compare_option::include_prerelease);
+      if (result > 0) {
+        lower = { &v, inclusive };
+      } else if (result == 0 && !inclusive) {
+        lower.inclusive = false;
+      }
+    }
+
+    SEMVER_CONSTEXPR void tighten_upper(const version<I1, I2, I3>& v, bool inclusive) noexcept {
+      const int result = upper.v == nullptr ? -1 : detail::compare_parsed(v, *upper.v, version_compare_option::include_prerelease);
+      if (result < 0) {
+        upper = { &v, inclusive };
+      } else if (result == 0 && !inclusive) {
+        upper.inclusive = false;
+      }
+    }
+  };
+
+  template <typename I1, typename I2, typename I3>
+  class range_parser;
+
+  class range_builder;
+}
+
+// Why one range of a range_set, `a b` in `a b || c`, rejects a version.
+struct range_rejection {
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  std::size_t range = 0;         // index in get_ranges()
+  std::size_t comparator = npos; // index in get_comparators() of the first comparator rejecting the version, npos if none does
+  bool prerelease = false;       // a prerelease no comparator of the range shares the numbers of, under exclude_prerelease
+};
+
+struct range_explanation {
+  bool contains = false;
+  std::size_t rejections = 0; // ranges rejecting the version, more than were written if the buffer is short
+};
+
+namespace detail {
+  template <typename I1, typename I2, typename I3>
+  class range {
+  public:
+    template <typename, typename, typename>
+    friend class detail::range_parser;
+    friend class detail::range_builder;
+
+    SEMVER_CONSTEXPR bool contains(const version<I1, I2, I3>& v, version_compare_option option) const noexcept {
+      if (option == version_compare_option::exclude_prerelease && !v.prerelease_tag().empty() && !prerelease_bounds) {
+        // a range without prerelease bounds rejects a prerelease without comparing anything
+        return false;
+      }
+
+      return detail::comparators_contain(ranges_comparators.begin(), ranges_comparators.end(), v, option);
+    }
+
+    // A release passes the prerelease gate under either option.
+    SEMVER_CONSTEXPR bool contains(const core_version<I1, I2, I3>& v) const noexcept {
+      return std::all_of(ranges_comparators.begin(), ranges_comparators.end(), [&](const auto& ranges_comparator) {
+        return ranges_comparator.contains(v);
+      });
+    }
+
+    // Same as contains, also recording why `v` is rejected. Kept apart from contains, which
+    // stops at the first failure and records nothing.
+    SEMVER_CONSTEXPR bool explain(const version<I1, I2, I3>& v, version_compare_option option, range_rejection& out) const noexcept {
+      out.prerelease = option == version_compare_option::exclude_prerelease && !match_at_least_one_comparator_with_prerelease(v);
+      out.comparator = range_rejection::npos;
+      for (std::size_t i = 0; i < ranges_comparators.size(); ++i) {
+        if (!ranges_comparators[i].contains(v)) {
+          out.comparator = i;
+          break;
+        }
+      }
+      return !out.prerelease && out.comparator == range_rejection::npos;
+    }
+
+    SEMVER_CONSTEXPR range_interval<I1, I2, I3> interval() const noexcept {
+      range_interval<I1, I2, I3> result;
+      for (const auto& ranges_comparator : ranges_comparators) {
+        const auto& v = ranges_comparator.get_version();
+        switch (ranges_comparator.get_operator()) {
+        case range_operator::less:
+          result.tighten_upper(v, false);
+          break;
+        case range_operator::less_or_equal:
+          result.tighten_upper(v, true);
+          break;
+        case range_operator::greater:
+          result.tighten_lower(v, false);
+          break;
+        case range_operator::greater_or_equal:
+          result.tighten_lower(v, true);
+          break;
+        case range_operator::equal:
+          result.tighten_lower(v, true);
+          result.tighten_upper(v, true);
+          break;
+        }
+      }
+      return result;
+    }
+
+    SEMVER_CONSTEXPR const std::vector<range_comparator<I1, I2, I3>>& get_comparators() const noexcept { return ranges_comparators; }
+
+    SEMVER_CONSTEXPR bool match_at_least_one_comparator_with_prerelease(const version<I1, I2, I3>& v) const noexcept {
+      if (v.prerelease_tag().empty()) {
+        return true;
+      }
+      if (!prerelease_bounds) {
+        return false;
+      }
+
+      return std::any_of(ranges_comparators.begin(), ranges_comparators.end(), [&](const auto& ranges_comparator) {
+        const bool has_prerelease = !ranges_comparator.get_version().prerelease_tag().empty();
+        const bool equal_without_prerelease = detail::compare_parsed(v, ranges_comparator.get_version(), version_compare_option::exclude_prerelease) == 0;
+        return has_prerelease && equal_without_prerelease;
+      });
+    }
+
+  private:
+    std::vector<range_comparator<I1, I2, I3>> ranges_comparators;
+    bool prerelease_bounds = false; // some comparator has a prerelease bound, set by range_parser and range_builder
+
+    SEMVER_CONSTEXPR void find_prerelease_bounds() noexcept {
+      prerelease_bounds = std::any_of(ranges_comparators.begin(), ranges_comparators.end(), [](const auto& ranges_comparator) {
+        return !ranges_comparator.get_version().prerelease_tag().empty();
+      });
+    }
+  };
+}
+
+template <typename I1, typename I2, typename I3>
+class version_table;
+
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+class range_set {
+public:
+  template <typename, typename, typename>
+  friend class detail::range_parser;
+  friend class detail::range_builder;
+
+  SEMVER_CONSTEXPR bool contains(const version<I1, I2, I3>& v, version_compare_option option = version_compare_option::exclude_prerelease) const noexcept {
+    return std::any_of(ranges.begin(), ranges.end(), [&](const auto& range) {
+      return range.contains(v, option);
+    });
+  }
+
+  SEMVER_CONSTEXPR bool contains(const core_version<I1, I2, I3>& v, version_compare_option = version_compare_option::exclude_prerelease) const noexcept {
+    return std::any_of(ranges.begin(), ranges.end(), [&](const auto& range) {
+      return range.contains(v);
+    });
+  }
+
+  SEMVER_CONSTEXPR const std::vector<detail::range<I1, I2, I3>>& get_ranges() const noexcept { return ranges; }
+
+  // Same result as contains, and a range_rejection for every range rejecting `v`, written to
+  // [first, last) in order while there is room.
+  SEMVER_CONSTEXPR range_explanation explain(const version<I1, I2, I3>& v, range_rejection* first, range_rejection* last, version_compare_option option = version_compare_option::exclude_prerelease) const noexcept {
+    range_explanation result;
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+      range_rejection rejection;
+      rejection.range = i;
+      if (ranges[i].explain(v, option, rejection)) {
+        result.contains = true;
+      } else {
+        if (first != last) {
+          *first++ = rejection;
+        }
+        ++result.rejections;
+      }
+    }
+    return result;
+  }
+
+  // Canonical form: each range reduced to its bounds, empty and redundant ranges dropped,
+  // overlapping ranges merged and the rest sorted. It contains the same versions as the
+  // original under both version_compare_options; a range containing nothing is "<0.0.0-0".
+  SEMVER_CONSTEXPR std::string to_string() const;
+
+  // Consistent with to_string(), so reordered or redundant spellings of a range hash equally.
+  SEMVER_CONSTEXPR std::size_t canonical_hash() const;
+
+  // Evaluates the range against every row of the table at once, as if calling contains on each.
+  SEMVER_CONSTEXPR void filter(const version_table<I1, I2, I3>& table, std::vector<bool>& out, version_compare_option option = version_compare_option::exclude_prerelease) const;
+
+  // Same as above, `out` set to the indices of the matching rows; both overloads replace what `out` held.
+  SEMVER_CONSTEXPR void filter(const version_table<I1, I2, I3>& table, std::vector<std::size_t>& out, version_compare_option option = version_compare_option::exclude_prerelease) const;
+
+private:
+  std::vector<detail::range<I1, I2, I3>> ranges;
+};
+
+namespace detail {
+  // Builds the ranges of a range_set from what range_scanner reads.
+  template <typename I1, typename I2, typename I3>
+  class range_parser {
+  public:
+    SEMVER_CONSTEXPR std::errc add(const desugared_range<I1, I2, I3>& desugared, const written_version<I1, I2, I3>& lower, const written_version<I1, I2, I3>& upper) {
+      if (&lower == &upper) {
+        const auto v = make(lower);
+        add(range_.ranges_comparators, desugared, v, v);
+      } else {
+        add(range_.ranges_comparators, desugared, make(lower), make(upper));
+      }
+      return std::errc{};
+    }
+
+    SEMVER_CONSTEXPR std::errc next_range() {
+      range_.find_prerelease_bounds();
+      ranges_.push_back(std::move(range_));
+      range_ = {};
+      return std::errc{};
+    }
+
+    SEMVER_CONSTEXPR void finish(range_set<I1, I2, I3>& out) { out.ranges = std::move(ranges_); }
+
+    // The comparators of `range`, those as written against `lower` or `upper`.
+    SEMVER_CONSTEXPR static void add(std::vector<detail::range_comparator<I1, I2, I3>>& out, const desugared_range<I1, I2, I3>& range,
+                                     const version<I1, I2, I3>& lower, const version<I1, I2, I3>& upper) {
+      for (std::size_t i = 0; i < range.size; ++i) {
+        const auto& c = range.comparators[i];
+        if (c.as_written) {
+          const bool is_upper = c.op == range_operator::less || c.op == range_operator::less_or_equal;
+          out.emplace_back(is_upper ? upper : lower, c.op);
+        } else {
+          constexpr std::string_view zero_prerelease = "0";
+          out.emplace_back(version_builder::make(c.major, c.minor, c.patch, c.zero_prerelease ? zero_prerelease : std::string_view{}), c.op);
+        }
+      }
+    }
+
+  private:
+    std::vector<range<I1, I2, I3>> ranges_;
+    range<I1, I2, I3> range_;
+
+    SEMVER_CONSTEXPR static version<I1, I2, I3> make(const written_version<I1, I2, I3>& v) {
+      return version_builder::make(v.partial.major, v.partial.minor, v.partial.patch, v.prerelease_tag, v.build_metadata);
+    }
+  };
+} // namespace semver::detail
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR from_chars_result parse(std::string_view str, range_set<I1, I2, I3>& out) {
+  detail::range_parser<I1, I2, I3> parser;
+  const from_chars_result result = detail::range_scanner<I1, I2, I3>{ str }.parse(parser);
+  if (result) {
+    parser.finish(out);
+  }
+  return result;
+}
+
+namespace detail {
+  template <typename It>
+  inline constexpr bool is_random_access_v = std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+  // Orders versions for the searches below; a sequence of something else, such as the entries of a
+  // mapped_catalog, brings an order comparing its elements to each other and to versions the same way.
+  struct version_order {
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR int operator()(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs, version_compare_option option) const noexcept {
+      return detail::compare_parsed(lhs, rhs, option);
+    }
+  };
+
+  // Positions [first, last) of a sorted sequence that lie inside the interval of the range.
+  template <typename It, typename I1, typename I2, typename I3, typename Order = version_order>
+  SEMVER_CONSTEXPR std::pair<It, It> equal_range(It first, It last, const range<I1, I2, I3>& r, Order order = {}) {
+    const auto bounds = r.interval();
+    if (bounds.lower.v != nullptr) {
+      first = std::partition_point(first, last, [&](const auto& element) {
+        const int result = order(element, *bounds.lower.v, version_compare_option::include_prerelease);
+        return bounds.lower.inclusive ? result < 0 : result <= 0;
+      });
+    }
+
+    if (bounds.upper.v != nullptr) {
+      last = std::partition_point(first, last, [&](const auto& element) {
+        const int result = order(element, *bounds.upper.v, version_compare_option::include_prerelease);
+        return bounds.upper.inclusive ? result <= 0 : result < 0;
+      });
+    }
+
+    return { first, last };
+  }
+
+  // The last position of a sorted sequence satisfying the range, or `last`. `gate(element)` is the
+  // prerelease gate of the range for one element. Prereleases of one major.minor.patch are adjacent
+  // and are either all allowed by exclude_prerelease or none, so a rejected one lets the search jump
+  // over all of them. catalog, mapped_catalog and max_satisfying over sorted input all search with it.
+  template <typename It, typename I1, typename I2, typename I3, typename Order, typename Gate>
+  SEMVER_CONSTEXPR It last_satisfying(It first, It last, const range<I1, I2, I3>& r, version_compare_option option, Order order, Gate gate) {
+    auto [begin, end] = detail::equal_range(first, last, r, order);
+    while (begin != end) {
+      const auto& top = *(end - 1);
+      if (option == version_compare_option::include_prerelease || gate(top)) {
+        return end - 1;
+      }
+
+      end = std::partition_point(begin, end - 1, [&](const auto& other) {
+        return order(other, top, version_compare_option::exclude_prerelease) < 0;
+      });
+    }
+    return last;
+  }
+
+  template <typename It, typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR It last_satisfying(It first, It last, const range<I1, I2, I3>& r, version_compare_option option) {
+    return detail::last_satisfying(first, last, r, option, version_order{}, [&](const version<I1, I2, I3>& v) {
+      return r.match_at_least_one_comparator_with_prerelease(v);
+    });
+  }
+
+  template <typename It, typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR It first_satisfying(It first, It last, const range<I1, I2, I3>& r, version_compare_option option) {
+    auto [begin, end] = detail::equal_range(first, last, r);
+    while (begin != end) {
+      const auto& v = *begin;
+      if (option == version_compare_option::include_prerelease || r.match_at_least_one_comparator_with_prerelease(v)) {
+        return begin;
+      }
+
+      begin = std::partition_point(begin, end, [&](const auto& other) {
+        return !other.prerelease_tag().empty() && detail::compare_parsed(other, v, version_compare_option::exclude_prerelease) == 0;
+      });
+    }
+    return last;
+  }
+
+  template <typename It, typename I1, typename I2, typename I3, typename Better>
+  SEMVER_CONSTEXPR It find_satisfying(It first, It last, const range_set<I1, I2, I3>& range, version_compare_option option, Better better) {
+    It result = last;
+    for (It it = first; it != last; ++it) {
+      if ((result == last || better(*it, *result)) && range.contains(*it, option)) {
+        result = it;
+      }
+    }
+    return result;
+  }
+} // namespace semver::detail
+
+// Highest version in [first, last) satisfying the range, or `last` if there is none.
+// The input is scanned linearly unless the caller vouches with sequence_order::sorted that it is in
+// ascending precedence; with random access iterators that is searched in O(log n).
+template <typename It, typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR It max_satisfying(It first, It last, const range_set<I1, I2, I3>& range,
+                                   version_compare_option option = version_compare_option::exclude_prerelease,
+                                   sequence_order order = sequence_order::unsorted) {
+  if constexpr (detail::is_random_access_v<It>) {
+    if (order == sequence_order::sorted) {
+      It result = last;
+      for (const auto& r : range.get_ranges()) {
+        const It it = detail::last_satisfying(first, last, r, option);
+        if (it != last && (result == last || result < it)) {
+          result = it;
+        }
+      }
+      return result;
+    }
+  }
+
+  return detail::find_satisfying(first, last, range, option, [](const auto& lhs, const auto& rhs) {
+    return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) >= 0;
+  });
+}
+
+// Lowest version in [first, last) satisfying the range, or `last` if there is none, searched like max_satisfying.
+template <typename It, typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR It min_satisfying(It first, It last, const range_set<I1, I2, I3>& range,
+                                   version_compare_option option = version_compare_option::exclude_prerelease,
+                                   sequence_order order = sequence_order::unsorted) {
+  if constexpr (detail::is_random_access_v<It>) {
+    if (order == sequence_order::sorted) {
+      It result = last;
+      for (const auto& r : range.get_ranges()) {
+        const It it = detail::first_satisfying(first, last, r, option);
+        if (it != last && (result == last || it < result)) {
+          result = it;
+        }
+      }
+      return result;
+    }
+  }
+
+  return detail::find_satisfying(first, last, range, option, [](const auto& lhs, const auto& rhs) {
+    return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) < 0;
+  });
+}
+
+// Sorted list of versions where every version has a rank (its position),
+// so a range turns into a few rank intervals found by binary search.
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+class catalog {
+public:
+  using const_iterator = typename std::vector<version<I1, I2, I3>>::const_iterator;
+
+  // Ranks [first, last) of versions satisfying a range.
+  struct interval {
+    std::size_t first;
+    std::size_t last;
+  };
+
+  SEMVER_CONSTEXPR catalog() = default;
+
+  SEMVER_CONSTEXPR explicit catalog(std::vector<version<I1, I2, I3>> versions) : versions_{std::move(versions)} {
+    std::sort(versions_.begin(), versions_.end(), less{});
+
+    for (std::size_t i = 0; i < versions_.size(); ++i) {
+      if (versions_[i].prerelease_tag().empty()) {
+        continue;
+      }
+
+      const bool same_core = !blocks_.empty() && blocks_.back().last == i &&
+        detail::compare_parsed(versions_[i], versions_[i - 1], version_compare_option::exclude_prerelease) == 0;
+      if (same_core) {
+        ++blocks_.back().last;
+      } else {
+        blocks_.push_back({ i, i + 1 });
+      }
+    }
+  }
+
+  SEMVER_CONSTEXPR std::size_t size() const noexcept { return versions_.size(); }
+
+  SEMVER_CONSTEXPR bool empty() const noexcept { return versions_.empty(); }
+
+  SEMVER_CONSTEXPR const_iterator begin() const noexcept { return versions_.begin(); }
+
+  SEMVER_CONSTEXPR const_iterator end() const noexcept { return versions_.end(); }
+
+  SEMVER_CONSTEXPR const version<I1, I2, I3>& operator[](std::size_t rank) const noexcept { return versions_[rank]; }
+
+  // Rank of the first version not less than `v`.
+  SEMVER_CONSTEXPR std::size_t rank(const version<I1, I2, I3>& v) const {
+    return static_cast<std::size_t>(std::lower_bound(versions_.begin(), versions_.end(), v, less{}) - versions_.begin());
+  }
+
+  // Sorted, disjoint and non-adjacent rank intervals of all versions satisfying the range.
+  SEMVER_CONSTEXPR std::vector<interval> satisfying(const range_set<I1, I2, I3>& range, version_compare_option option = version_compare_option::exclude_prerelease) const {
+    std::vector<interval> intervals;
+    for (const auto& r : range.get_ranges()) {
+      for_each_interval(r, option, [&](std::size_t first, std::size_t last) {
+        intervals.push_back({ first, last });
+      });
+    }
+
+    std::sort(intervals.begin(), intervals.end(), [](const interval& lhs, const interval& rhs) { return lhs.first < rhs.first; });
+
+    std::vector<interval> result;
+    for (const auto& i : intervals) {
+      if (!result.empty() && i.first <= result.back().last) {
+        result.back().last = std::max(result.back().last, i.last);
+      } else {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  SEMVER_CONSTEXPR std::vector<bool> satisfying_bitmap(const range_set<I1, I2, I3>& range, version_compare_option option = version_compare_option::exclude_prerelease) const {
+    std::vector<bool> result(versions_.size());
+    for (const auto& r : range.get_ranges()) {
+      for_each_interval(r, option, [&](std::size_t first, std::size_t last) {
+        std::fill(result.begin() + static_cast<std::ptrdiff_t>(first), result.begin() + static_cast<std::ptrdiff_t>(last), true);
+      });
+    }
+    return result;
+  }
+
+  // Highest version satisfying the range, or end().
+  SEMVER_CONSTEXPR const_iterator max_satisfying(const range_set<I1, I2, I3>& range, version_compare_option option = version_compare_option::exclude_prerelease) const {
+    return semver::max_satisfying(begin(), end(), range, option, sequence_order::sorted);
+  }
+
+  // Lowest version satisfying the range, or end().
+  SEMVER_CONSTEXPR const_iterator min_satisfying(const range_set<I1, I2, I3>& range, version_compare_option option = version_compare_option::exclude_prerelease) const {
+    std::size_t result = npos;
+    for (const auto& r : range.get_ranges()) {
+      const auto [first, last] = rank_interval(r);
+      for_each_interval(r, first, last, option, [&](std::size_t i, std::size_t) {
+        result = std::min(result, i);
+        return false;
+      });
+    }
+    return result == npos ? end() : begin() + static_cast<std::ptrdiff_t>(result);
+  }
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  struct less {
+    SEMVER_CONSTEXPR bool operator()(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) const noexcept {
+      return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) < 0;
+    }
+  };
+
+  std::vector<version<I1, I2, I3>> versions_;
+  // Runs of prereleases sharing major.minor.patch. With exclude_prerelease a range takes or skips a run as a whole.
+  std::vector<interval> blocks_;
+
+  SEMVER_CONSTEXPR interval rank_interval(const detail::range<I1, I2, I3>& r) const {
+    const auto [first, last] = detail::equal_range(versions_.begin(), versions_.end(), r);
+    return { static_cast<std::size_t>(first - versions_.begin()), static_cast<std::size_t>(last - versions_.begin()) };
+  }
+
+  template <typename F>
+  SEMVER_CONSTEXPR void for_each_interval(const detail::range<I1, I2, I3>& r, version_compare_option option, F&& f) const {
+    const auto [first, last] = rank_interval(r);
+    for_each_interval(r, first, last, option, [&](std::size_t i, std::size_t j) {
+      f(i, j);
+      return true;
+    });
+  }
+
+  // Calls `f(first, last)` for every satisfying interval inside [first, last) in ascending order while it returns true.
+  template <typename F>
+  SEMVER_CONSTEXPR void for_each_interval(const detail::range<I1, I2, I3>& r, std::size_t first, std::size_t last, version_compare_option option, F&& f) const {
+    if (first == last) {
+      return;
+    }
+
+    if (option == version_compare_option::include_prerelease) {
+      f(first, last);
+      return;
+    }
+
+    auto block = std::upper_bound(blocks_.begin(), blocks_.end(), first, [](std::size_t rank, const interval& b) { return rank < b.last; });
+    std::size_t current = first;
+    for (; block != blocks_.end() && block->first < last; ++block) {
+      const std::size_t block_first = std::max(block->first, current);
+      const std::size_t block_last = std::min(block->last, last);
+      if (r.match_at_least_one_comparator_with_prerelease(versions_[block->first])) {
+        continue;
+      }
+
+      if (current < block_first && !f(current, block_first)) {
+        return;
+      }
+      current = block_last;
+    }
+
+    if (current < last) {
+      f(current, last);
+    }
+  }
+};
+
+// Versions stored column by column, so a range can be checked against all of them in one pass.
+// Rows with a prerelease tag also keep the whole version for the prerelease rules.
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+class version_table {
+public:
+  SEMVER_CONSTEXPR version_table() = default;
+
+  template <typename It>
+  SEMVER_CONSTEXPR version_table(It first, It last) {
+    if constexpr (detail::is_random_access_v<It>) {
+      reserve(static_cast<std::size_t>(std::distance(first, last)));
+    }
+
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  SEMVER_CONSTEXPR void reserve(std::size_t capacity) {
+    majors_.reserve(capacity);
+    minors_.reserve(capacity);
+    patches_.reserve(capacity);
+  }
+
+  SEMVER_CONSTEXPR void push_back(const version<I1, I2, I3>& v) {
+    if (!v.prerelease_tag().empty()) {
+      prereleases_.push_back({ majors_.size(), v });
+    }
+
+    majors_.push_back(v.major());
+    minors_.push_back(v.minor());
+    patches_.push_back(v.patch());
+  }
+
+  SEMVER_CONSTEXPR void clear() noexcept {
+    majors_.clear();
+    minors_.clear();
+    patches_.clear();
+    prereleases_.clear();
+  }
+
+  SEMVER_CONSTEXPR std::size_t size() const noexcept { return majors_.size(); }
+
+  SEMVER_CONSTEXPR bool empty() const noexcept { return majors_.empty(); }
+
+  SEMVER_CONSTEXPR const std::vector<I1>& majors() const noexcept { return majors_; }
+
+  SEMVER_CONSTEXPR const std::vector<I2>& minors() const noexcept { return minors_; }
+
+  SEMVER_CONSTEXPR const std::vector<I3>& patches() const noexcept { return patches_; }
+
+  // Row and version of every row with a prerelease tag, by row.
+  SEMVER_CONSTEXPR const std::vector<std::pair<std::size_t, version<I1, I2, I3>>>& prereleases() const noexcept { return prereleases_; }
+
+private:
+  std::vector<I1> majors_;
+  std::vector<I2> minors_;
+  std::vector<I3> patches_;
+  std::vector<std::pair<std::size_t, version<I1, I2, I3>>> prereleases_;
+};
+
+namespace detail {
+  // Sets `mask[row - first]` for the release rows in [first, last) contained by the range, `scratch`
+  // holds as many bytes. The loops have no branches on the data, so the compiler vectorizes them.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR void filter_releases(const range_set<I1, I2, I3>& rs, const version_table<I1, I2, I3>& table, std::size_t first, std::size_t last,
+                                        std::uint8_t* mask, std::uint8_t* scratch) noexcept {
+    const std::size_t size = last - first;
+    const I1* majors = table.majors().data() + first;
+    const I2* minors = table.minors().data() + first;
+    const I3* patches = table.patches().data() + first;
+
+    std::fill(mask, mask + size, std::uint8_t{0});
+    for (const auto& r : rs.get_ranges()) {
+      std::fill(scratch, scratch + size, std::uint8_t{1});
+
+      for (const auto& c : r.get_comparators()) {
+        const auto& v = c.get_version();
+        const I1 major = v.major();
+        const I2 minor = v.minor();
+        const I3 patch = v.patch();
+        // a release is greater than any prerelease of its major.minor.patch
+        const unsigned equal_is_greater = v.prerelease_tag().empty() ? 0U : 1U;
+
+        // which of less, equal and greater than `v` the operator accepts
+        unsigned accept_less = 0;
+        unsigned accept_equal = 0;
+        unsigned accept_greater = 0;
+        switch (c.get_operator()) {
+        case range_operator::less:
+          accept_less = 1;
+          break;
+        case range_operator::less_or_equal:
+          accept_less = accept_equal = 1;
+          break;
+        case range_operator::greater:
+          accept_greater = 1;
+          break;
+        case range_operator::greater_or_equal:
+          accept_greater = accept_equal = 1;
+          break;
+        case range_operator::equal:
+          accept_equal = 1;
+          break;
+        }
+        // equal numbers compare as greater than a prerelease `v`
+        const unsigned accept_same_core = equal_is_greater != 0 ? accept_greater : accept_equal;
+
+        // 0/1 masks of one width combined with & and |, no shifts by data and no branches, so the compiler can vectorize it
+        for (std::size_t i = 0; i < size; ++i) {
+          const unsigned major_less = majors[i] < major;
+          const unsigned major_equal = majors[i] == major;
+          const unsigned minor_less = minors[i] < minor;
+          const unsigned minor_equal = minors[i] == minor;
+          const unsigned patch_less = patches[i] < patch;
+          const unsigned patch_equal = patches[i] == patch;
+          const unsigned less = major_less | (major_equal & (minor_less | (minor_equal & patch_less)));
+          const unsigned same_core = major_equal & minor_equal & patch_equal;
+          const unsigned greater = (less | same_core) ^ 1U;
+          const unsigned accepted = (less & accept_less) | (same_core & accept_same_core) | (greater & accept_greater);
+          scratch[i] &= static_cast<std::uint8_t>(accepted);
+        }
+      }
+
+      for (std::size_t i = 0; i < size; ++i) {
+        mask[i] |= scratch[i];
+      }
+    }
+  }
+
+  // Prerelease rows go through contains, which knows the prerelease rules.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR void filter_prereleases(const range_set<I1, I2, I3>& rs, const version_table<I1, I2, I3>& table, std::size_t first, std::size_t last,
+                                           std::uint8_t* mask, version_compare_option option) {
+    const auto& prereleases = table.prereleases();
+    auto it = std::lower_bound(prereleases.begin(), prereleases.end(), first, [](const auto& p, std::size_t row) { return p.first < row; });
+    for (; it != prereleases.end() && it->first < last; ++it) {
+      mask[it->first - first] = rs.contains(it->second, option) ? 1 : 0;
+    }
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR void filter(const range_set<I1, I2, I3>& rs, const version_table<I1, I2, I3>& table, std::vector<std::uint8_t>& mask, version_compare_option option) {
+    mask.resize(table.size());
+    std::vector<std::uint8_t> scratch(table.size());
+    filter_releases(rs, table, 0, table.size(), mask.data(), scratch.data());
+    filter_prereleases(rs, table, 0, table.size(), mask.data(), option);
+  }
+} // namespace semver::detail
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR void range_set<I1, I2, I3>::filter(const version_table<I1, I2, I3>& table, std::vector<bool>& out, version_compare_option option) const {
+  std::vector<std::uint8_t> mask;
+  detail::filter(*this, table, mask, option);
+  out.assign(mask.begin(), mask.end());
+}
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR void range_set<I1, I2, I3>::filter(const version_table<I1, I2, I3>& table, std::vector<std::size_t>& out, version_compare_option option) const {
+  std::vector<std::uint8_t> mask;
+  detail::filter(*this, table, mask, option);
+  // every row is written and only matching rows are kept, a branch on the mask would be mispredicted half the time
+  out.resize(mask.size());
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < mask.size(); ++i) {
+    out[count] = i;
+    count += mask[i];
+  }
+  out.resize(count);
+}
+
+namespace detail {
+  class range_builder {
+  public:
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static void add(range<I1, I2, I3>& r, const version<I1, I2, I3>& v, range_operator op) {
+      r.ranges_comparators.emplace_back(v, op);
+      r.prerelease_bounds = r.prerelease_bounds || !v.prerelease_tag().empty();
+    }
+
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static void add(range<I1, I2, I3>& r, const desugared_range<I1, I2, I3>& desugared, const version<I1, I2, I3>& lower,
+                                     const version<I1, I2, I3>& upper) {
+      range_parser<I1, I2, I3>::add(r.ranges_comparators, desugared, lower, upper);
+      r.find_prerelease_bounds();
+    }
+
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static void add(range_set<I1, I2, I3>& rs, range<I1, I2, I3> r) {
+      rs.ranges.push_back(std::move(r));
+    }
+
+  };
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR bool less(const version<I1, I2, I3>& lhs, const version<I1, I2, I3>& rhs) noexcept {
+    return detail::compare_parsed(lhs, rhs, version_compare_option::include_prerelease) < 0;
+  }
+
+  // [lower, upper) in precedence order, `bounded == false` means there is no upper bound.
+  // Every version has a successor, so inclusive and exclusive bounds reduce to this one form.
+  template <typename I1, typename I2, typename I3>
+  struct half_open_interval {
+    version<I1, I2, I3> lower;
+    version<I1, I2, I3> upper;
+    bool bounded = false;
+
+    SEMVER_CONSTEXPR bool empty() const noexcept { return bounded && !detail::less(lower, upper); }
+
+    SEMVER_CONSTEXPR bool ends_before(const half_open_interval& other) const noexcept {
+      return bounded && (!other.bounded || detail::less(upper, other.upper));
+    }
+  };
+
+  // Sorted, disjoint and non-adjacent intervals.
+  template <typename I1, typename I2, typename I3>
+  using interval_list = std::vector<half_open_interval<I1, I2, I3>>;
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR version<I1, I2, I3> min_version() {
+    return version_builder::make(I1{0}, I2{0}, I3{0}, "0");
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR half_open_interval<I1, I2, I3> to_half_open(const range_interval<I1, I2, I3>& i) {
+    half_open_interval<I1, I2, I3> result{ min_version<I1, I2, I3>(), {}, false };
+
+    if (i.lower.v != nullptr) {
+      if (i.lower.inclusive) {
+        result.lower = *i.lower.v;
+      } else if (!version_builder::successor(*i.lower.v, result.lower)) {
+        return { *i.lower.v, *i.lower.v, true };
+      }
+    }
+
+    if (i.upper.v != nullptr) {
+      result.bounded = !i.upper.inclusive || version_builder::successor(*i.upper.v, result.upper);
+      if (!i.upper.inclusive) {
+        result.upper = *i.upper.v;
+      }
+    }
+
+    return result;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR void normalize(interval_list<I1, I2, I3>& intervals) {
+    intervals.erase(std::remove_if(intervals.begin(), intervals.end(), [](const auto& i) { return i.empty(); }), intervals.end());
+    std::sort(intervals.begin(), intervals.end(), [](const auto& lhs, const auto& rhs) { return detail::less(lhs.lower, rhs.lower); });
+
+    interval_list<I1, I2, I3> result;
+    for (auto& i : intervals) {
+      if (!result.empty() && (!result.back().bounded || !detail::less(result.back().upper, i.lower))) {
+        if (result.back().ends_before(i)) {
+          result.back().upper = std::move(i.upper);
+          result.back().bounded = i.bounded;
+        }
+      } else {
+        result.push_back(std::move(i));
+      }
+    }
+    intervals = std::move(result);
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR interval_list<I1, I2, I3> unite(const interval_list<I1, I2, I3>& lhs, const interval_list<I1, I2, I3>& rhs) {
+    interval_list<I1, I2, I3> result = lhs;
+    result.insert(result.end(), rhs.begin(), rhs.end());
+    normalize(result);
+    return result;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR interval_list<I1, I2, I3> intersect(const interval_list<I1, I2, I3>& lhs, const interval_list<I1, I2, I3>& rhs) {
+    interval_list<I1, I2, I3> result;
+    for (std::size_t i = 0, j = 0; i < lhs.size() && j < rhs.size();) {
+      const auto& a = lhs[i];
+      const auto& b = rhs[j];
+      const auto& first = a.ends_before(b) ? a : b;
+      half_open_interval<I1, I2, I3> overlap{ detail::less(a.lower, b.lower) ? b.lower : a.lower, first.upper, first.bounded };
+      if (!overlap.empty()) {
+        result.push_back(std::move(overlap));
+      }
+      a.ends_before(b) ? ++i : ++j;
+    }
+    return result;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR interval_list<I1, I2, I3> subtract(const interval_list<I1, I2, I3>& lhs, const interval_list<I1, I2, I3>& rhs) {
+    interval_list<I1, I2, I3> result;
+    for (const auto& a : lhs) {
+      half_open_interval<I1, I2, I3> rest = a;
+      for (const auto& b : rhs) {
+        if (rest.empty() || (rest.bounded && !detail::less(b.lower, rest.upper))) {
+          break;
+        }
+
+        if (b.bounded && !detail::less(rest.lower, b.upper)) {
+          continue;
+        }
+
+        if (detail::less(rest.lower, b.lower)) {
+          result.push_back({ rest.lower, b.lower, true });
+        }
+
+        if (!b.bounded) {
+          rest.bounded = true;
+          rest.upper = rest.lower;
+        } else {
+          rest.lower = b.upper;
+        }
+      }
+
+      if (!rest.empty()) {
+        result.push_back(std::move(rest));
+      }
+    }
+    return result;
+  }
+
+  // The set of versions a range_set contains, as intervals.
+  // With exclude_prerelease `intervals` only contributes its releases, and the prereleases a range lets in
+  // (those sharing major.minor.patch with one of its comparators) are kept per major.minor.patch.
+  template <typename I1, typename I2, typename I3>
+  struct range_decomposition {
+    interval_list<I1, I2, I3> intervals;
+    std::vector<std::pair<version<I1, I2, I3>, interval_list<I1, I2, I3>>> prereleases;
+
+    SEMVER_CONSTEXPR interval_list<I1, I2, I3>& prereleases_of(const version<I1, I2, I3>& core) {
+      auto it = std::lower_bound(prereleases.begin(), prereleases.end(), core, [](const auto& p, const auto& v) { return detail::less(p.first, v); });
+      if (it == prereleases.end() || detail::less(core, it->first)) {
+        it = prereleases.insert(it, { core, {} });
+      }
+      return it->second;
+    }
+  };
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR range_decomposition<I1, I2, I3> decompose(const range_set<I1, I2, I3>& rs, version_compare_option option) {
+    range_decomposition<I1, I2, I3> result;
+    for (const auto& r : rs.get_ranges()) {
+      auto i = to_half_open(r.interval());
+      if (i.empty()) {
+        continue;
+      }
+
+      if (option == version_compare_option::exclude_prerelease) {
+        for (const auto& c : r.get_comparators()) {
+          const auto& v = c.get_version();
+          if (v.prerelease_tag().empty()) {
+            continue;
+          }
+
+          auto core = version_builder::core(v);
+          const half_open_interval<I1, I2, I3> prereleases{ version_builder::make(v.major(), v.minor(), v.patch(), "0"), core, true };
+          auto clipped = intersect(interval_list<I1, I2, I3>{ i }, interval_list<I1, I2, I3>{ prereleases });
+          if (!clipped.empty()) {
+            auto& list = result.prereleases_of(core);
+            list.insert(list.end(), clipped.begin(), clipped.end());
+          }
+        }
+      }
+
+      result.intervals.push_back(std::move(i));
+    }
+
+    normalize(result.intervals);
+    for (auto& p : result.prereleases) {
+      normalize(p.second);
+    }
+    return result;
+  }
+
+  template <typename I1, typename I2, typename I3, typename Op>
+  SEMVER_CONSTEXPR range_decomposition<I1, I2, I3> combine(const range_decomposition<I1, I2, I3>& lhs, const range_decomposition<I1, I2, I3>& rhs, Op op) {
+    range_decomposition<I1, I2, I3> result;
+    result.intervals = op(lhs.intervals, rhs.intervals);
+
+    const interval_list<I1, I2, I3> none;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < lhs.prereleases.size() || j < rhs.prereleases.size()) {
+      const bool take_lhs = j == rhs.prereleases.size() || (i < lhs.prereleases.size() && !detail::less(rhs.prereleases[j].first, lhs.prereleases[i].first));
+      const bool take_rhs = i == lhs.prereleases.size() || (j < rhs.prereleases.size() && !detail::less(lhs.prereleases[i].first, rhs.prereleases[j].first));
+
+      auto list = op(take_lhs ? lhs.prereleases[i].second : none, take_rhs ? rhs.prereleases[j].second : none);
+      if (!list.empty()) {
+        result.prereleases.push_back({ take_lhs ? lhs.prereleases[i].first : rhs.prereleases[j].first, std::move(list) });
+      }
+
+      i += take_lhs ? 1 : 0;
+      j += take_rhs ? 1 : 0;
+    }
+    return result;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR bool is_successor(const version<I1, I2, I3>& v, const version<I1, I2, I3>& next) {
+    version<I1, I2, I3> successor;
+    return version_builder::successor(v, successor) && detail::compare_parsed(successor, next, version_compare_option::include_prerelease) == 0;
+  }
+
+  // Comparators for an interval whose bounds may both be used as the prerelease gate.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR range<I1, I2, I3> make_range(const half_open_interval<I1, I2, I3>& i, bool keep_prerelease_bounds) {
+    range<I1, I2, I3> result;
+    if (i.bounded && is_successor(i.lower, i.upper)) {
+      range_builder::add(result, i.lower, range_operator::equal);
+      return result;
+    }
+
+    version<I1, I2, I3> v;
+    if (version_builder::predecessor(i.lower, v) && (!keep_prerelease_bounds || !v.prerelease_tag().empty())) {
+      range_builder::add(result, v, range_operator::greater);
+    } else {
+      range_builder::add(result, i.lower, range_operator::greater_or_equal);
+    }
+
+    if (i.bounded) {
+      if (version_builder::predecessor(i.upper, v) && (!keep_prerelease_bounds || !v.prerelease_tag().empty())) {
+        range_builder::add(result, v, range_operator::less_or_equal);
+      } else {
+        range_builder::add(result, i.upper, range_operator::less);
+      }
+    }
+    return result;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR bool has_release(const half_open_interval<I1, I2, I3>& i) {
+    return !i.bounded || detail::less(version_builder::core(i.lower), version_builder::core(i.upper));
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR bool is_empty(const range<I1, I2, I3>& r, version_compare_option option) {
+    const auto i = to_half_open(r.interval());
+    if (i.empty()) {
+      return true;
+    }
+
+    if (option == version_compare_option::include_prerelease || has_release(i)) {
+      return false;
+    }
+
+    // Only prereleases are left, which need a comparator with the same major.minor.patch.
+    return std::none_of(r.get_comparators().begin(), r.get_comparators().end(), [&](const auto& c) {
+      const auto& v = c.get_version();
+      if (v.prerelease_tag().empty()) {
+        return false;
+      }
+
+      const auto first = version_builder::make(v.major(), v.minor(), v.patch(), "0");
+      const auto last = version_builder::core(v);
+      return detail::less(i.lower, last) && (!i.bounded || detail::less(first, i.upper));
+    });
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR bool is_empty(const range_decomposition<I1, I2, I3>& d, version_compare_option option) {
+    if (!d.prereleases.empty()) {
+      return false;
+    }
+
+    if (option == version_compare_option::include_prerelease) {
+      return d.intervals.empty();
+    }
+
+    return std::none_of(d.intervals.begin(), d.intervals.end(), [](const auto& i) { return has_release(i); });
+  }
+
+  // Comparators without prerelease tags, matching exactly the releases of the interval:
+  // a release is below `M.m.p-x` exactly when it is below `M.m.p`.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR bool make_release_range(const half_open_interval<I1, I2, I3>& i, range<I1, I2, I3>& out) {
+    if (!has_release(i)) {
+      return false;
+    }
+
+    const auto lower = version_builder::core(i.lower);
+    const auto upper = version_builder::core(i.upper);
+
+    if (i.bounded && upper.major() == lower.major() && upper.minor() == lower.minor() && upper.patch() - lower.patch() == 1) {
+      range_builder::add(out, lower, range_operator::equal);
+      return true;
+    }
+
+    range_builder::add(out, lower, range_operator::greater_or_equal);
+    if (i.bounded) {
+      range_builder::add(out, upper, range_operator::less);
+    }
+    return true;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR range_set<I1, I2, I3> compose(const range_decomposition<I1, I2, I3>& d, version_compare_option option) {
+    std::vector<std::pair<version<I1, I2, I3>, range<I1, I2, I3>>> ranges;
+
+    for (const auto& i : d.intervals) {
+      range<I1, I2, I3> r;
+      if (option == version_compare_option::include_prerelease) {
+        ranges.push_back({ i.lower, make_range(i, false) });
+      } else if (make_release_range(i, r)) {
+        ranges.push_back({ r.get_comparators().front().get_version(), std::move(r) });
+      }
+    }
+
+    for (const auto& p : d.prereleases) {
+      for (const auto& i : p.second) {
+        ranges.push_back({ i.lower, make_range(i, true) });
+      }
+    }
+
+    std::sort(ranges.begin(), ranges.end(), [](const auto& lhs, const auto& rhs) { return detail::less(lhs.first, rhs.first); });
+
+    range_set<I1, I2, I3> result;
+    for (auto& r : ranges) {
+      range_builder::add(result, std::move(r.second));
+    }
+    return result;
+  }
+  template <typename I1, typename I2, typename I3>
+  struct canonical_range {
+    range_bound<I1, I2, I3> lower;
+    range_bound<I1, I2, I3> upper;
+    half_open_interval<I1, I2, I3> hull;
+
+    SEMVER_CONSTEXPR bool is_equal() const noexcept {
+      return lower.v != nullptr && upper.v != nullptr && lower.inclusive && upper.inclusive && detail::compare_parsed(*lower.v, *upper.v, version_compare_option::include_prerelease) == 0;
+    }
+
+    // A prerelease bound lets in the prereleases of its major.minor.patch, if the hull reaches them.
+    SEMVER_CONSTEXPR bool is_gate(const range_bound<I1, I2, I3>& bound) const {
+      if (bound.v == nullptr || bound.v->prerelease_tag().empty()) {
+        return false;
+      }
+
+      const auto first = version_builder::make(bound.v->major(), bound.v->minor(), bound.v->patch(), "0");
+      return detail::less(hull.lower, version_builder::core(*bound.v)) && (!hull.bounded || detail::less(first, hull.upper));
+    }
+
+    SEMVER_CONSTEXPR bool has_gate() const { return is_gate(lower) || is_gate(upper); }
+
+    SEMVER_CONSTEXPR bool admits_gate(const range_bound<I1, I2, I3>& bound) const noexcept {
+      const auto same_core = [&](const range_bound<I1, I2, I3>& other) {
+        return other.v != nullptr && !other.v->prerelease_tag().empty() && detail::compare_parsed(*bound.v, *other.v, version_compare_option::exclude_prerelease) == 0;
+      };
+      return same_core(lower) || same_core(upper);
+    }
+
+    SEMVER_CONSTEXPR bool contains(const canonical_range& other) const {
+      const bool lower_contains = !detail::less(other.hull.lower, hull.lower);
+      const bool upper_contains = !hull.bounded || (other.hull.bounded && !detail::less(hull.upper, other.hull.upper));
+      return lower_contains && upper_contains && (!other.is_gate(other.lower) || admits_gate(other.lower)) && (!other.is_gate(other.upper) || admits_gate(other.upper));
+    }
+  };
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR int compare_bound(const range_bound<I1, I2, I3>& lhs, const range_bound<I1, I2, I3>& rhs, bool upper) noexcept {
+    if (lhs.v == nullptr || rhs.v == nullptr) {
+      return (lhs.v != nullptr) - (rhs.v != nullptr);
+    }
+
+    if (const int result = detail::compare_parsed(*lhs.v, *rhs.v, version_compare_option::include_prerelease); result != 0) {
+      return result;
+    }
+    return upper ? lhs.inclusive - rhs.inclusive : rhs.inclusive - lhs.inclusive;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR std::vector<canonical_range<I1, I2, I3>> canonicalize(const range_set<I1, I2, I3>& rs) {
+    std::vector<canonical_range<I1, I2, I3>> ranges;
+    for (const auto& r : rs.get_ranges()) {
+      const auto i = r.interval();
+      auto hull = to_half_open(i);
+      if (!hull.empty()) {
+        ranges.push_back({ i.lower, i.upper, std::move(hull) });
+      }
+    }
+
+    std::sort(ranges.begin(), ranges.end(), [](const auto& lhs, const auto& rhs) {
+      if (const int result = compare_bound(lhs.lower, rhs.lower, false); result != 0) {
+        return result < 0;
+      }
+      // an unbounded upper sorts last
+      const int result = compare_bound(lhs.upper, rhs.upper, true);
+      return lhs.upper.v == nullptr || rhs.upper.v == nullptr ? result > 0 : result < 0;
+    });
+
+    // Ranges that let in no prereleases of their own merge like plain intervals.
+    std::vector<canonical_range<I1, I2, I3>> merged;
+    for (auto& r : ranges) {
+      if (!merged.empty() && !merged.back().has_gate() && !r.has_gate() && (!merged.back().hull.bounded || !detail::less(merged.back().hull.upper, r.hull.lower))) {
+        if (merged.back().hull.ends_before(r.hull)) {
+          merged.back().upper = r.upper;
+          merged.back().hull.upper = std::move(r.hull.upper);
+          merged.back().hull.bounded = r.hull.bounded;
+        }
+      } else {
+        merged.push_back(std::move(r));
+      }
+    }
+
+    std::vector<canonical_range<I1, I2, I3>> result;
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+      const bool redundant = std::any_of(merged.begin(), merged.end(), [&](const auto& other) {
+        const std::size_t j = static_cast<std::size_t>(&other - merged.data());
+        return j != i && other.contains(merged[i]) && (j < i || !merged[i].contains(other));
+      });
+      if (!redundant) {
+        result.push_back(merged[i]);
+      }
+    }
+    return result;
+  }
+
+  // Build metadata takes no part in precedence and is left out.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR std::size_t canonical_length(const version<I1, I2, I3>& v) noexcept {
+    return detail::length(v.major()) + detail::length(v.minor()) + detail::length(v.patch()) + 2
+      + (v.prerelease_tag().empty() ? 0 : v.prerelease_tag().length() + 1);
+  }
+
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR char* canonical_to_chars(char* dest, const version<I1, I2, I3>& v) noexcept {
+    dest += canonical_length(v);
+    auto it = dest;
+    if (!v.prerelease_tag().empty()) {
+      it = std::copy_backward(v.prerelease_tag().begin(), v.prerelease_tag().end(), it);
+      *(--it) = '-';
+    }
+
+    it = detail::to_chars(it, v.patch());
+    *(--it) = '.';
+    it = detail::to_chars(it, v.minor());
+    *(--it) = '.';
+    detail::to_chars(it, v.major());
+    return dest;
+  }
+
+  // Writes `ranges` to [first, last), or only measures them if `first` is null.
+  template <typename I1, typename I2, typename I3>
+  SEMVER_CONSTEXPR std::size_t canonical_to_chars(char* first, const std::vector<canonical_range<I1, I2, I3>>& ranges) noexcept {
+    std::size_t size = 0;
+    const auto write = [&](std::string_view str) {
+      if (first != nullptr) {
+        first = std::copy(str.begin(), str.end(), first);
+      }
+      size += str.size();
+    };
+    const auto write_version = [&](const version<I1, I2, I3>& v) {
+      if (first != nullptr) {
+        first = canonical_to_chars(first, v);
+      }
+      size += canonical_length(v);
+    };
+
+    if (ranges.empty()) {
+      write("<0.0.0-0");
+    }
+
+    for (const auto& r : ranges) {
+      if (&r != ranges.data()) {
+        write(" || ");
+      }
+
+      if (r.is_equal()) {
+        write_version(*r.lower.v);
+        continue;
+      }
+
+      if (r.lower.v == nullptr && r.upper.v == nullptr) {
+        write("*");
+      }
+
+      if (r.lower.v != nullptr) {
+        write(r.lower.inclusive ? ">=" : ">");
+        write_version(*r.lower.v);
+      }
+
+      if (r.upper.v != nullptr) {
+        if (r.lower.v != nullptr) {
+          write(" ");
+        }
+        write(r.upper.inclusive ? "<=" : "<");
+        write_version(*r.upper.v);
+      }
+    }
+    return size;
+  }
+} // namespace semver::detail
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR std::string range_set<I1, I2, I3>::to_string() const {
+  const auto canonical = detail::canonicalize(*this);
+
+  std::string result;
+  detail::resize_uninitialized<std::string>{}.resize(result, detail::canonical_to_chars(static_cast<char*>(nullptr), canonical));
+  detail::canonical_to_chars(result.data(), canonical);
+  return result;
+}
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR std::size_t range_set<I1, I2, I3>::canonical_hash() const {
+  detail::version_hasher hasher;
+  const auto add = [&](const detail::range_bound<I1, I2, I3>& bound) {
+    hasher.add(static_cast<std::uint64_t>(bound.v == nullptr ? 0 : bound.inclusive ? 1 : 2));
+    hasher.add(bound.v == nullptr ? 0 : static_cast<std::uint64_t>(bound.v->hash()));
+  };
+
+  for (const auto& r : detail::canonicalize(*this)) {
+    add(r.lower);
+    add(r.upper);
+  }
+  return hasher.result();
+}
+
+// Writes the canonical form of the range, see range_set::to_string.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR to_chars_result to_chars(char* first, char* last, const range_set<I1, I2, I3>& range) {
+  const auto canonical = detail::canonicalize(range);
+  if (detail::canonical_to_chars(static_cast<char*>(nullptr), canonical) > static_cast<std::size_t>(last - first)) {
+    return to_chars_result{ last, std::errc::value_too_large };
+  }
+  return to_chars_result{ first + detail::canonical_to_chars(first, canonical), std::errc{} };
+}
+
+// Versions contained by both ranges. The result is exact for the given option.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR range_set<I1, I2, I3> intersect(const range_set<I1, I2, I3>& lhs, const range_set<I1, I2, I3>& rhs, version_compare_option option = version_compare_option::exclude_prerelease) {
+  const auto op = [](const auto& a, const auto& b) { return detail::intersect(a, b); };
+  return detail::compose(detail::combine(detail::decompose(lhs, option), detail::decompose(rhs, option), op), option);
+}
+
+// Versions contained by either range. The result is exact for the given option.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR range_set<I1, I2, I3> unite(const range_set<I1, I2, I3>& lhs, const range_set<I1, I2, I3>& rhs, version_compare_option option = version_compare_option::exclude_prerelease) {
+  const auto op = [](const auto& a, const auto& b) { return detail::unite(a, b); };
+  return detail::compose(detail::combine(detail::decompose(lhs, option), detail::decompose(rhs, option), op), option);
+}
+
+// Versions contained by `lhs` but not by `rhs`. The result is exact for the given option.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR range_set<I1, I2, I3> difference(const range_set<I1, I2, I3>& lhs, const range_set<I1, I2, I3>& rhs, version_compare_option option = version_compare_option::exclude_prerelease) {
+  const auto op = [](const auto& a, const auto& b) { return detail::subtract(a, b); };
+  return detail::compose(detail::combine(detail::decompose(lhs, option), detail::decompose(rhs, option), op), option);
+}
+
+// True if no version is contained by the range, without enumerating candidates.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR bool is_empty(const range_set<I1, I2, I3>& range, version_compare_option option = version_compare_option::exclude_prerelease) {
+  return std::all_of(range.get_ranges().begin(), range.get_ranges().end(), [&](const auto& r) { return detail::is_empty(r, option); });
+}
+
+// True if every version contained by `lhs` is also contained by `rhs`.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR bool is_subset(const range_set<I1, I2, I3>& lhs, const range_set<I1, I2, I3>& rhs, version_compare_option option = version_compare_option::exclude_prerelease) {
+  const auto op = [](const auto& a, const auto& b) { return detail::subtract(a, b); };
+  return detail::is_empty(detail::combine(detail::decompose(lhs, option), detail::decompose(rhs, option), op), option);
+}
+
+// Versions not contained by the range. With exclude_prerelease no range can let in
+// prereleases of every major.minor.patch, so the complement holds releases only.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR range_set<I1, I2, I3> complement(const range_set<I1, I2, I3>& range, version_compare_option option = version_compare_option::exclude_prerelease) {
+  detail::range_decomposition<I1, I2, I3> all;
+  all.intervals.push_back({ detail::min_version<I1, I2, I3>(), {}, false });
+
+  const auto op = [](const auto& a, const auto& b) { return detail::subtract(a, b); };
+  return detail::compose(detail::combine(all, detail::decompose(range, option), op), option);
+}
+
+// Many range sets, indexed to find the ones containing a version without visiting the others.
+// Every range is an interval in a treap ordered by lower bound, where each node also keeps the
+// greatest upper bound below it, so a query is O(log n + k) expected. Nodes refer to the bounds
+// by comparator index in the range sets they index, and hold no versions of their own.
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+class range_index {
+public:
+  using id_type = std::size_t;
+
+  SEMVER_CONSTEXPR range_index() = default;
+
+  // Ids of erased range sets are reused.
+  SEMVER_CONSTEXPR id_type insert(range_set<I1, I2, I3> range) {
+    id_type id = entries_.size();
+    if (free_entries_.empty()) {
+      entries_.emplace_back();
+    } else {
+      id = free_entries_.back();
+      free_entries_.pop_back();
+    }
+
+    auto& e = entries_[id];
+    e.range = std::move(range);
+    e.live = true;
+    for (std::size_t i = 0; i < e.range.get_ranges().size(); ++i) {
+      const auto& r = e.range.get_ranges()[i];
+      const auto interval = r.interval();
+      if (detail::to_half_open(interval).empty()) {
+        continue;
+      }
+
+      const std::size_t n = make_node(id, i, comparator_of(r, interval.lower), comparator_of(r, interval.upper));
+      entries_[id].nodes.push_back(n);
+      root_ = insert(root_, n);
+    }
+
+    ++size_;
+    return id;
+  }
+
+  SEMVER_CONSTEXPR bool erase(id_type id) {
+    if (id >= entries_.size() || !entries_[id].live) {
+      return false;
+    }
+
+    auto& e = entries_[id];
+    for (std::size_t n : e.nodes) {
+      root_ = erase(root_, n);
+      free_nodes_.push_back(n);
+    }
+
+    e.nodes.clear();
+    e.range = {};
+    e.live = false;
+    free_entries_.push_back(id);
+    --size_;
+    return true;
+  }
+
+  SEMVER_CONSTEXPR bool contains(id_type id) const noexcept { return id < entries_.size() && entries_[id].live; }
+
+  SEMVER_CONSTEXPR const range_set<I1, I2, I3>& operator[](id_type id) const noexcept { return entries_[id].range; }
+
+  SEMVER_CONSTEXPR std::size_t size() const noexcept { return size_; }
+
+  SEMVER_CONSTEXPR bool empty() const noexcept { return size_ == 0; }
+
+  // Appends the sorted ids of the range sets containing `v`, as range_set::contains would tell.
+  SEMVER_CONSTEXPR void ranges_containing(const version<I1, I2, I3>& v, std::vector<id_type>& out, version_compare_option option = version_compare_option::exclude_prerelease) const {
+    const std::size_t first = out.size();
+    const bool check_prerelease = option == version_compare_option::exclude_prerelease && !v.prerelease_tag().empty();
+
+    collect(root_, v, [&](const node& n) {
+      if (!check_prerelease || entries_[n.id].range.get_ranges()[n.range].match_at_least_one_comparator_with_prerelease(v)) {
+        out.push_back(n.id);
+      }
+    });
+
+    // a range set with several ranges may contain `v` more than once
+    std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+    out.erase(std::unique(out.begin() + static_cast<std::ptrdiff_t>(first), out.end()), out.end());
+  }
+
+  SEMVER_CONSTEXPR std::vector<id_type> ranges_containing(const version<I1, I2, I3>& v, version_compare_option option = version_compare_option::exclude_prerelease) const {
+    std::vector<id_type> result;
+    ranges_containing(v, result, option);
+    return result;
+  }
+
+private:
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+  static constexpr std::uint32_t unbounded = std::numeric_limits<std::uint32_t>::max();
+
+  struct entry {
+    range_set<I1, I2, I3> range;
+    std::vector<std::size_t> nodes;
+    bool live = false;
+  };
+
+  // One side of a node's interval, the comparator of the range that sets it or `unbounded`.
+  struct bound {
+    std::uint32_t comparator = unbounded;
+    bool inclusive = false;
+  };
+
+  struct node {
+    id_type id = 0;
+    std::uint32_t range = 0;
+    bound lower;
+    bound upper;
+    std::uint64_t priority = 0;
+    std::size_t left = npos;
+    std::size_t right = npos;
+    // the node below with the greatest upper bound, this one included
+    std::size_t max = npos;
+  };
+
+  std::vector<entry> entries_;
+  std::vector<id_type> free_entries_;
+  std::vector<node> nodes_;
+  std::vector<std::size_t> free_nodes_;
+  std::size_t root_ = npos;
+  std::size_t size_ = 0;
+  std::uint64_t seed_ = 0x9e3779b97f4a7c15ULL;
+
+  static SEMVER_CONSTEXPR bound comparator_of(const detail::range<I1, I2, I3>& r, const detail::range_bound<I1, I2, I3>& b) noexcept {
+    const auto& comparators = r.get_comparators();
+    for (std::size_t i = 0; i < comparators.size(); ++i) {
+      if (&comparators[i].get_version() == b.v) {
+        return { static_cast<std::uint32_t>(i), b.inclusive };
+      }
+    }
+    return {};
+  }
+
+  SEMVER_CONSTEXPR const version<I1, I2, I3>& version_of(const node& n, bound b) const noexcept {
+    return entries_[n.id].range.get_ranges()[n.range].get_comparators()[b.comparator].get_version();
+  }
+
+  // `v` is at or after the lower bound of `n`.
+  SEMVER_CONSTEXPR bool starts_by(const node& n, const version<I1, I2, I3>& v) const noexcept {
+    if (n.lower.comparator == unbounded) {
+      return true;
+    }
+    const auto& lower = version_of(n, n.lower);
+    return n.lower.inclusive ? !detail::less(v, lower) : detail::less(lower, v);
+  }
+
+  // `v` is before the upper bound of `n`.
+  SEMVER_CONSTEXPR bool ends_after(const node& n, const version<I1, I2, I3>& v) const noexcept {
+    if (n.upper.comparator == unbounded) {
+      return true;
+    }
+    const auto& upper = version_of(n, n.upper);
+    return n.upper.inclusive ? !detail::less(upper, v) : detail::less(v, upper);
+  }
+
+  // The upper bound of `lhs` is before the one of `rhs`, `<= v` counting as before `< successor`.
+  SEMVER_CONSTEXPR bool ends_before(const node& lhs, const node& rhs) const noexcept {
+    if (lhs.upper.comparator == unbounded || rhs.upper.comparator == unbounded) {
+      return rhs.upper.comparator == unbounded && lhs.upper.comparator != unbounded;
+    }
+    const int result = detail::compare_parsed(version_of(lhs, lhs.upper), version_of(rhs, rhs.upper), version_compare_option::include_prerelease);
+    return result < 0 || (result == 0 && !lhs.upper.inclusive && rhs.upper.inclusive);
+  }
+
+  SEMVER_CONSTEXPR std::size_t make_node(id_type id, std::size_t range, bound lower, bound upper) {
+    // splitmix64
+    seed_ += 0x9e3779b97f4a7c15ULL;
+    std::uint64_t priority = seed_;
+    priority = (priority ^ (priority >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    priority = (priority ^ (priority >> 27)) * 0x94d049bb133111ebULL;
+    priority ^= priority >> 31;
+
+    std::size_t n = nodes_.size();
+    if (free_nodes_.empty()) {
+      nodes_.emplace_back();
+    } else {
+      n = free_nodes_.back();
+      free_nodes_.pop_back();
+    }
+
+    nodes_[n] = { id, static_cast<std::uint32_t>(range), lower, upper, priority, npos, npos, n };
+    return n;
+  }
+
+  // Nodes are ordered by lower bound, `>= v` before `> v`, ties broken by node index.
+  SEMVER_CONSTEXPR bool key_less(std::size_t lhs, std::size_t rhs) const noexcept {
+    const auto& l = nodes_[lhs];
+    const auto& r = nodes_[rhs];
+    int result = 0;
+    if (l.lower.comparator == unbounded || r.lower.comparator == unbounded) {
+      result = (l.lower.comparator != unbounded) - (r.lower.comparator != unbounded);
+    } else {
+      result = detail::compare_parsed(version_of(l, l.lower), version_of(r, r.lower), version_compare_option::include_prerelease);
+      if (result == 0) {
+        result = l.lower.inclusive == r.lower.inclusive ? 0 : (l.lower.inclusive ? -1 : 1);
+      }
+    }
+    return result < 0 || (result == 0 && lhs < rhs);
+  }
+
+  SEMVER_CONSTEXPR void update(std::size_t t) noexcept {
+    auto& n = nodes_[t];
+    n.max = t;
+    for (std::size_t child : { n.left, n.right }) {
+      if (child != npos && ends_before(nodes_[n.max], nodes_[nodes_[child].max])) {
+        n.max = nodes_[child].max;
+      }
+    }
+  }
+
+  // Splits the treap `t` into the nodes ordered before `key` and the rest.
+  SEMVER_CONSTEXPR std::pair<std::size_t, std::size_t> split(std::size_t t, std::size_t key) noexcept {
+    if (t == npos) {
+      return { npos, npos };
+    }
+
+    if (key_less(t, key)) {
+      const auto [left, right] = split(nodes_[t].right, key);
+      nodes_[t].right = left;
+      update(t);
+      return { t, right };
+    }
+
+    const auto [left, right] = split(nodes_[t].left, key);
+    nodes_[t].left = right;
+    update(t);
+    return { left, t };
+  }
+
+  // Joins two treaps where every node of `lhs` is ordered before every node of `rhs`.
+  SEMVER_CONSTEXPR std::size_t merge(std::size_t lhs, std::size_t rhs) noexcept {
+    if (lhs == npos || rhs == npos) {
+      return lhs == npos ? rhs : lhs;
+    }
+
+    if (nodes_[lhs].priority > nodes_[rhs].priority) {
+      nodes_[lhs].right = merge(nodes_[lhs].right, rhs);
+      update(lhs);
+      return lhs;
+    }
+
+    nodes_[rhs].left = merge(lhs, nodes_[rhs].left);
+    update(rhs);
+    return rhs;
+  }
+
+  SEMVER_CONSTEXPR std::size_t insert(std::size_t t, std::size_t n) noexcept {
+    if (t == npos) {
+      return n;
+    }
+
+    if (nodes_[n].priority > nodes_[t].priority) {
+      const auto [left, right] = split(t, n);
+      nodes_[n].left = left;
+      nodes_[n].right = right;
+      update(n);
+      return n;
+    }
+
+    if (key_less(n, t)) {
+      nodes_[t].left = insert(nodes_[t].left, n);
+    } else {
+      nodes_[t].right = insert(nodes_[t].right, n);
+    }
+    update(t);
+    return t;
+  }
+
+  SEMVER_CONSTEXPR std::size_t erase(std::size_t t, std::size_t n) noexcept {
+    if (t == n) {
+      const std::size_t result = merge(nodes_[t].left, nodes_[t].right);
+      nodes_[t].left = npos;
+      nodes_[t].right = npos;
+      return result;
+    }
+
+    if (key_less(n, t)) {
+      nodes_[t].left = erase(nodes_[t].left, n);
+    } else {
+      nodes_[t].right = erase(nodes_[t].right, n);
+    }
+    update(t);
+    return t;
+  }
+
+  template <typename F>
+  SEMVER_CONSTEXPR void collect(std::size_t t, const version<I1, I2, I3>& v, F&& f) const {
+    if (t == npos) {
+      return;
+    }
+
+    // every interval below ends at or before `v`
+    if (!ends_after(nodes_[nodes_[t].max], v)) {
+      return;
+    }
+
+    const auto& n = nodes_[t];
+    collect(n.left, v, f);
+
+    // this node and the ones to its right start after `v`
+    if (!starts_by(n, v)) {
+      return;
+    }
+
+    if (ends_after(n, v)) {
+      f(n);
+    }
+    collect(n.right, v, f);
+  }
+};
+
+namespace detail {
+  // Parses one version a character at a time, keeping only what it has built so far,
+  // so the text may arrive in any number of pieces.
+  template <typename I1, typename I2, typename I3>
+  class version_automaton {
+  public:
+    enum class status : std::uint8_t {
+      more,  // the character was consumed
+      done,  // the version ended before the character, which was not consumed
+      invalid,
+      out_of_range
+    };
+
+    // `partial` allows the shorter forms of ranges, like `1.2` or `1.x`, without prerelease or build metadata.
+    SEMVER_CONSTEXPR void reset(bool partial) noexcept {
+      value_.clear();
+      partial_ = {};
+      allow_partial_ = partial;
+      wildcard_ = false;
+      state_ = state::number;
+      component_ = 0;
+      number_ = 0;
+      digits_ = 0;
+    }
+
+    SEMVER_CONSTEXPR status push(char c) {
+      switch (state_) {
+      case state::number:
+        if (digits_ == 0) {
+          if (allow_partial_ && (c == 'x' || c == 'X' || c == '*')) {
+            wildcard_ = true;
+            state_ = state::component;
+            return status::more;
+          }
+          if (!is_digit(c) || wildcard_) {
+            return status::invalid;
+          }
+        } else if (!is_digit(c)) {
+          if (!commit_number()) {
+            return status::out_of_range;
+          }
+          state_ = state::component;
+          return push(c);
+        } else if (number_ == 0) {
+          return status::invalid;
+        }
+
+        number_ = number_ * 10 + to_digit(c);
+        ++digits_;
+        // 19 digits always fit in 64 bits, number_in_range does the rest
+        return digits_ < 20 ? status::more : status::out_of_range;
+      case state::component:
+        if (c == '.' && component_ < 2) {
+          ++component_;
+          state_ = state::number;
+          return status::more;
+        }
+        if (component_ == 2 && !wildcard_ && (c == '-' || c == '+')) {
+          state_ = c == '-' ? state::prerelease_start : state::build_start;
+          return status::more;
+        }
+        if (component_ < 2 && !allow_partial_) {
+          return status::invalid;
+        }
+        // `01`, `1.x1` and `1x` are malformed, not two comparators side by side
+        if (is_digit(c) || is_letter(c) || c == '*') {
+          return status::invalid;
+        }
+        return complete();
+      case state::prerelease_start:
+        if (!is_identifier_symbol(c)) {
+          return status::invalid;
+        }
+        if (!value_.prerelease_tag_.empty()) {
+          value_.prerelease_tag_.push_back('.');
+        }
+        value_.prerelease_identifiers.push_back({ prerelease_identifier_type::numeric, {} });
+        state_ = state::prerelease;
+        return push(c);
+      case state::prerelease:
+        if (is_identifier_symbol(c)) {
+          value_.prerelease_tag_.push_back(c);
+          value_.prerelease_identifiers.back().identifier.push_back(c);
+          if (!is_digit(c)) {
+            value_.prerelease_identifiers.back().type = prerelease_identifier_type::alphanumeric;
+          }
+          return status::more;
+        }
+        if (const auto& last = value_.prerelease_identifiers.back();
+            last.type == prerelease_identifier_type::numeric && last.identifier.size() > 1 && last.identifier[0] == '0') {
+          return status::invalid;
+        }
+        if (c == '.' || c == '+') {
+          state_ = c == '.' ? state::prerelease_start : state::build_start;
+          return status::more;
+        }
+        return complete();
+      case state::build_start:
+        if (!is_identifier_symbol(c)) {
+          return status::invalid;
+        }
+        if (!value_.build_metadata_.empty()) {
+          value_.build_metadata_.push_back('.');
+        }
+        state_ = state::build;
+        return push(c);
+      case state::build:
+        if (is_identifier_symbol(c)) {
+          value_.build_metadata_.push_back(c);
+          return status::more;
+        }
+        if (c == '.') {
+          state_ = state::build_start;
+          return status::more;
+        }
+        return complete();
+      }
+      return status::invalid;
+    }
+
+    // The version as written; only meaningful if all three numbers were given.
+    SEMVER_CONSTEXPR version<I1, I2, I3>& value() noexcept { return value_; }
+
+    SEMVER_CONSTEXPR const partial_version<I1, I2, I3>& partial() const noexcept { return partial_; }
+
+  private:
+    enum class state : std::uint8_t {
+      number,
+      component,
+      prerelease_start,
+      prerelease,
+      build_start,
+      build
+    };
+
+    version<I1, I2, I3> value_;
+    partial_version<I1, I2, I3> partial_;
+    bool allow_partial_ = false;
+    bool wildcard_ = false;
+    state state_ = state::number;
+    int component_ = 0;
+    std::uint64_t number_ = 0;
+    int digits_ = 0;
+
+    SEMVER_CONSTEXPR static bool is_identifier_symbol(char c) noexcept {
+      return c == '-' || is_digit(c) || is_letter(c);
+    }
+
+    SEMVER_CONSTEXPR bool commit_number() noexcept {
+      bool in_range = false;
+      if (component_ == 0) {
+        in_range = number_in_range<I1>(number_);
+        partial_.major = static_cast<I1>(number_);
+      } else if (component_ == 1) {
+        in_range = number_in_range<I2>(number_);
+        partial_.minor = static_cast<I2>(number_);
+      } else {
+        in_range = number_in_range<I3>(number_);
+        partial_.patch = static_cast<I3>(number_);
+      }
+      ++partial_.components;
+      number_ = 0;
+      digits_ = 0;
+      return in_range;
+    }
+
+    SEMVER_CONSTEXPR status complete() {
+      if (partial_.components == 3) {
+        value_.major_ = partial_.major;
+        value_.minor_ = partial_.minor;
+        value_.patch_ = partial_.patch;
+        value_.hash_ = hash_version(value_.major_, value_.minor_, value_.patch_, value_.prerelease_tag_);
+      }
+      return status::done;
+    }
+  };
+} // namespace semver::detail
+
+// Parses values out of text that arrives in pieces, e.g. network buffers, without gathering them:
+// each character is consumed once and every completed value is handed to a callback.
+// After an error the rest of the invalid value is skipped and parsing may go on after `ptr`.
+template <typename T>
+class incremental_parser;
+
+// Versions separated by whitespace.
+template <typename I1, typename I2, typename I3>
+class incremental_parser<version<I1, I2, I3>> {
+public:
+  template <typename F>
+  SEMVER_CONSTEXPR from_chars_result feed(std::string_view chunk, F&& on_version) {
+    for (const char& c : chunk) {
+      if (const auto ec = step(c, on_version); ec != std::errc{}) {
+        return detail::failure(&c, ec);
+      }
+    }
+    return detail::success(chunk.data() + chunk.size());
+  }
+
+  // The end of the input, completing a version still in progress; `ptr` is null.
+  template <typename F>
+  SEMVER_CONSTEXPR from_chars_result finish(F&& on_version) {
+    const auto ec = step('\n', on_version);
+    reset();
+    return ec == std::errc{} ? detail::success(nullptr) : detail::failure(nullptr, ec);
+  }
+
+  SEMVER_CONSTEXPR void reset() noexcept { state_ = state::between; }
+
+private:
+  enum class state : std::uint8_t {
+    between,
+    version,
+    skip
+  };
+
+  using automaton = detail::version_automaton<I1, I2, I3>;
+
+  automaton automaton_;
+  state state_ = state::between;
+
+  SEMVER_CONSTEXPR static bool is_space(char c) noexcept { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+  template <typename F>
+  SEMVER_CONSTEXPR std::errc step(char c, F& on_version) {
+    switch (state_) {
+    case state::between:
+      if (is_space(c)) {
+        return std::errc{};
+      }
+      automaton_.reset(false);
+      state_ = state::version;
+      [[fallthrough]];
+    case state::version: {
+      auto ec = std::errc::invalid_argument;
+      switch (automaton_.push(c)) {
+      case automaton::status::more:
+        return std::errc{};
+      case automaton::status::done:
+        if (is_space(c)) {
+          state_ = state::between;
+          on_version(automaton_.value());
+          return std::errc{};
+        }
+        break;
+      case automaton::status::invalid:
+        break;
+      case automaton::status::out_of_range:
+        ec = std::errc::result_out_of_range;
+        break;
+      }
+      state_ = is_space(c) ? state::between : state::skip;
+      return ec;
+    }
+    case state::skip:
+      if (is_space(c)) {
+        state_ = state::between;
+      }
+      return std::errc{};
+    }
+    return std::errc::invalid_argument;
+  }
+};
+
+// Range sets, one per line; blank lines are skipped. Unlike parse, the whole line must be a range set.
+template <typename I1, typename I2, typename I3>
+class incremental_parser<range_set<I1, I2, I3>> {
+public:
+  template <typename F>
+  SEMVER_CONSTEXPR from_chars_result feed(std::string_view chunk, F&& on_range) {
+    for (const char& c : chunk) {
+      if (const auto ec = step(c, on_range); ec != std::errc{}) {
+        return detail::failure(&c, ec);
+      }
+    }
+    return detail::success(chunk.data() + chunk.size());
+  }
+
+  // The end of the input, completing a range set still in progress; `ptr` is null.
+  template <typename F>
+  SEMVER_CONSTEXPR from_chars_result finish(F&& on_range) {
+    const auto ec = step('\n', on_range);
+    reset();
+    return ec == std::errc{} ? detail::success(nullptr) : detail::failure(nullptr, ec);
+  }
+
+  SEMVER_CONSTEXPR void reset() {
+    state_ = state::line_start;
+    value_ = {};
+    range_ = {};
+    has_comparator_ = false;
+  }
+
+private:
+  enum class state : std::uint8_t {
+    line_start,
+    comparator_start,
+    less,
+    greater,
+    after_prefix,
+    version,
+    maybe_hyphen,
+    hyphen,
+    after_hyphen,
+    upper_version,
+    logical_or,
+    cr,
+    skip
+  };
+
+  using automaton = detail::version_automaton<I1, I2, I3>;
+
+  automaton automaton_;
+  range_set<I1, I2, I3> value_;
+  detail::range<I1, I2, I3> range_;
+  state state_ = state::line_start;
+  detail::range_operator op_ = detail::range_operator::equal;
+  detail::range_sugar sugar_ = detail::range_sugar::none;
+  // an operator or sugar came before the version, so it can not start a hyphen range
+  bool prefixed_ = false;
+  // `*` adds no comparators, so an empty range may still have been given
+  bool has_comparator_ = false;
+  bool spaces_ = false;
+  version<I1, I2, I3> lower_;
+  detail::partial_version<I1, I2, I3> lower_partial_;
+
+  template <typename F>
+  SEMVER_CONSTEXPR std::errc step(char c, F& on_range) {
+    while (true) {
+      switch (state_) {
+      case state::line_start:
+        if (c == ' ' || c == '\n') {
+          return std::errc{};
+        }
+        if (c == '\r') {
+          state_ = state::cr;
+          return std::errc{};
+        }
+        state_ = state::comparator_start;
+        continue;
+      case state::comparator_start:
+        op_ = detail::range_operator::equal;
+        sugar_ = detail::range_sugar::none;
+        prefixed_ = true;
+        switch (c) {
+        case ' ':
+          return std::errc{};
+        case '<':
+          state_ = state::less;
+          return std::errc{};
+        case '>':
+          state_ = state::greater;
+          return std::errc{};
+        case '=':
+          state_ = state::after_prefix;
+          return std::errc{};
+        case '^':
+          sugar_ = detail::range_sugar::caret;
+          state_ = state::after_prefix;
+          return std::errc{};
+        case '~':
+          sugar_ = detail::range_sugar::tilde;
+          state_ = state::after_prefix;
+          return std::errc{};
+        case '|':
+          if (range_empty()) {
+            return fail(c);
+          }
+          state_ = state::logical_or;
+          return std::errc{};
+        case '\r':
+          state_ = state::cr;
+          return std::errc{};
+        case '\n':
+          return end_line(c, on_range);
+        default:
+          prefixed_ = false;
+          state_ = state::after_prefix;
+          continue;
+        }
+      case state::less:
+      case state::greater: {
+        const bool or_equal = c == '=';
+        if (state_ == state::less) {
+          op_ = or_equal ? detail::range_operator::less_or_equal : detail::range_operator::less;
+        } else {
+          op_ = or_equal ? detail::range_operator::greater_or_equal : detail::range_operator::greater;
+        }
+        state_ = state::after_prefix;
+        if (or_equal) {
+          return std::errc{};
+        }
+        continue;
+      }
+      case state::after_prefix:
+        if (c == ' ' && prefixed_) {
+          return std::errc{};
+        }
+        automaton_.reset(true);
+        state_ = state::version;
+        continue;
+      case state::version:
+        if (const auto ec = push(c); ec != std::errc{} || state_ == state::version) {
+          return ec;
+        }
+        if (prefixed_) {
+          add(detail::desugar(sugar_, op_, automaton_.partial()), automaton_.value(), automaton_.value());
+          state_ = state::comparator_start;
+          continue;
+        }
+        lower_ = std::move(automaton_.value());
+        lower_partial_ = automaton_.partial();
+        spaces_ = false;
+        state_ = state::maybe_hyphen;
+        continue;
+      case state::maybe_hyphen:
+        if (c == ' ') {
+          spaces_ = true;
+          return std::errc{};
+        }
+        if (c == '-' && spaces_) {
+          state_ = state::hyphen;
+          return std::errc{};
+        }
+        add(detail::desugar(detail::range_sugar::none, detail::range_operator::equal, lower_partial_), lower_, lower_);
+        state_ = state::comparator_start;
+        continue;
+      case state::hyphen:
+        if (c != ' ') {
+          return fail(c);
+        }
+        state_ = state::after_hyphen;
+        return std::errc{};
+      case state::after_hyphen:
+        if (c == ' ') {
+          return std::errc{};
+        }
+        automaton_.reset(true);
+        state_ = state::upper_version;
+        continue;
+      case state::upper_version:
+        if (const auto ec = push(c); ec != std::errc{} || state_ == state::upper_version) {
+          return ec;
+        }
+        add(detail::desugar_hyphen(lower_partial_, automaton_.partial()), lower_, automaton_.value());
+        state_ = state::comparator_start;
+        continue;
+      case state::logical_or:
+        if (c != '|') {
+          return fail(c);
+        }
+        next_range();
+        state_ = state::comparator_start;
+        return std::errc{};
+      case state::cr:
+        if (c != '\n') {
+          return fail(c);
+        }
+        return end_line(c, on_range);
+      case state::skip:
+        if (c == '\n') {
+          state_ = state::line_start;
+        }
+        return std::errc{};
+      }
+      return std::errc::invalid_argument;
+    }
+  }
+
+  // Feeds the automaton; the state is left as it is while the version goes on.
+  SEMVER_CONSTEXPR std::errc push(char c) {
+    switch (automaton_.push(c)) {
+    case automaton::status::more:
+      return std::errc{};
+    case automaton::status::done:
+      state_ = state::comparator_start;
+      return std::errc{};
+    case automaton::status::invalid:
+      break;
+    case automaton::status::out_of_range:
+      return fail(c, std::errc::result_out_of_range);
+    }
+    return fail(c);
+  }
+
+  SEMVER_CONSTEXPR bool range_empty() const noexcept { return !has_comparator_; }
+
+  SEMVER_CONSTEXPR void add(const detail::desugared_range<I1, I2, I3>& desugared, const version<I1, I2, I3>& lower, const version<I1, I2, I3>& upper) {
+    detail::range_builder::add(range_, desugared, lower, upper);
+    has_comparator_ = true;
+  }
+
+  SEMVER_CONSTEXPR void next_range() {
+    detail::range_builder::add(value_, std::move(range_));
+    range_ = {};
+    has_comparator_ = false;
+  }
+
+  template <typename F>
+  SEMVER_CONSTEXPR std::errc end_line(char c, F& on_range) {
+    if (range_empty()) {
+      // a blank line ending in "\r\n" is still blank, a line ending in "||" is not
+      if (!value_.get_ranges().empty()) {
+        return fail(c);
+      }
+      state_ = state::line_start;
+      return std::errc{};
+    }
+
+    next_range();
+    state_ = state::line_start;
+    on_range(value_);
+    value_ = {};
+    return std::errc{};
+  }
+
+  SEMVER_CONSTEXPR std::errc fail(char c, std::errc ec = std::errc::invalid_argument) {
+    value_ = {};
+    range_ = {};
+    has_comparator_ = false;
+    state_ = c == '\n' ? state::line_start : state::skip;
+    return ec;
+  }
+};
+
 namespace detail {
-  template <typename I1, typename I2, typename I3>
-  class range_comparator {
+  // Compact binary encoding, every number is an unsigned LEB128 varint:
+  //
+  //   version    := major minor patch header identifier* build?
+  //   header     := identifier_count << 1 | has_build_metadata
+  //   identifier := length << 1 | is_numeric, then `length` bytes of text
+  //   build      := length, then `length` bytes of text
+  //   range_set  := range_count range*
+  //   range      := comparator_count (operator version)*, operator is one byte
+  class binary_codec {
   public:
-    SEMVER_CONSTEXPR range_comparator(const version<I1, I2, I3>& v, range_operator op) noexcept : v(v), op(op) {}
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static to_chars_result write(char* first, char* last, const version<I1, I2, I3>& v) noexcept {
+      writer out{ first, last };
+      write(out, v);
+      return out.result();
+    }
 
-    SEMVER_CONSTEXPR bool contains(const version<I1, I2, I3>& other) const noexcept {
-      switch (op) {
-      case range_operator::less:
-        return detail::compare_parsed(other, v, version_compare_option::include_prerelease) < 0;
-      case range_operator::less_or_equal:
-        return detail::compare_parsed(other, v, version_compare_option::include_prerelease) <= 0;
-      case range_operator::greater:
-        return detail::compare_parsed(other, v, version_compare_option::include_prerelease) > 0;
-      case range_operator::greater_or_equal:
-        return detail::compare_parsed(other, v, version_compare_option::include_prerelease) >= 0;
-      case range_operator::equal:
-        return detail::compare_parsed(other, v, version_compare_option::include_prerelease) == 0;
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static to_chars_result write(char* first, char* last, const range_set<I1, I2, I3>& rs) noexcept {
+      writer out{ first, last };
+      out.varint(rs.get_ranges().size());
+      for (const auto& r : rs.get_ranges()) {
+        out.varint(r.get_comparators().size());
+        for (const auto& comparator : r.get_comparators()) {
+          out.byte(static_cast<std::uint8_t>(comparator.get_operator()));
+          write(out, comparator.get_version());
+        }
       }
-      return false;
+      return out.result();
     }
 
-    SEMVER_CONSTEXPR const version<I1, I2, I3>& get_version() const noexcept { return v; }
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static from_chars_result read(const char* first, const char* last, version<I1, I2, I3>& out) {
+      reader in{ first, last };
+      return read(in, out);
+    }
+
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static from_chars_result read(const char* first, const char* last, range_set<I1, I2, I3>& out) {
+      reader in{ first, last };
+      std::uint64_t range_count = 0;
+      if (const auto res = in.varint(range_count); !res) {
+        return res;
+      }
+
+      range_set<I1, I2, I3> result;
+      for (std::uint64_t i = 0; i < range_count; ++i) {
+        std::uint64_t comparator_count = 0;
+        if (const auto res = in.varint(comparator_count); !res) {
+          return res;
+        }
+
+        range<I1, I2, I3> r;
+        for (std::uint64_t j = 0; j < comparator_count; ++j) {
+          std::uint8_t op = 0;
+          if (const auto res = in.byte(op); !res) {
+            return res;
+          }
+          if (op > static_cast<std::uint8_t>(range_operator::equal)) {
+            return failure(in.position() - 1);
+          }
+
+          version<I1, I2, I3> v;
+          if (const auto res = read(in, v); !res) {
+            return res;
+          }
+          range_builder::add(r, v, static_cast<range_operator>(op));
+        }
+        range_builder::add(result, std::move(r));
+      }
+
+      out = std::move(result);
+      return success(in.position());
+    }
 
   private:
-    version<I1, I2, I3> v;
-    range_operator op;
-  };
+    struct writer {
+      char* current;
+      char* last;
+      bool overflow = false;
+
+      SEMVER_CONSTEXPR void byte(std::uint8_t value) noexcept {
+        if (current == last) {
+          overflow = true;
+          return;
+        }
+        *current++ = static_cast<char>(value);
+      }
 
-  class range_parser;
+      SEMVER_CONSTEXPR void varint(std::uint64_t value) noexcept {
+        while (value >= 0x80) {
+          byte(static_cast<std::uint8_t>(value | 0x80));
+          value >>= 7;
+        }
+        byte(static_cast<std::uint8_t>(value));
+      }
 
-  template <typename I1, typename I2, typename I3>
-  class range {
-  public:
-    friend class detail::range_parser;
+      SEMVER_CONSTEXPR void text(std::string_view value) noexcept {
+        if (static_cast<std::size_t>(last - current) < value.size()) {
+          overflow = true;
+          current = last;
+          return;
+        }
+        current = std::copy(value.begin(), value.end(), current);
+      }
 
-    SEMVER_CONSTEXPR bool contains(const version<I1, I2, I3>& v, version_compare_option option) const noexcept {
-      if (option == version_compare_option::exclude_prerelease) {
-        if (!match_at_least_one_comparator_with_prerelease(v)) {
-          return false;
+      SEMVER_CONSTEXPR to_chars_result result() const noexcept {
+        return overflow ? to_chars_result{ last, std::errc::value_too_large } : to_chars_result{ current, std::errc{} };
+      }
+    };
+
+    struct reader {
+      const char* current;
+      const char* last;
+
+      SEMVER_CONSTEXPR from_chars_result byte(std::uint8_t& out) noexcept {
+        if (current == last) {
+          return failure(current);
         }
+        out = static_cast<std::uint8_t>(*current++);
+        return success(current);
       }
 
-      return std::all_of(ranges_comparators.begin(), ranges_comparators.end(), [&](const auto& ranges_comparator) {
-        return ranges_comparator.contains(v);
-      });
+      SEMVER_CONSTEXPR from_chars_result varint(std::uint64_t& out) noexcept {
+        out = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+          std::uint8_t value = 0;
+          if (const auto res = byte(value); !res) {
+            return res;
+          }
+          if (shift == 63 && value > 1) {
+            return failure(current - 1, std::errc::result_out_of_range);
+          }
+
+          out |= static_cast<std::uint64_t>(value & 0x7F) << shift;
+          if ((value & 0x80) == 0) {
+            return success(current);
+          }
+        }
+        return failure(current - 1, std::errc::result_out_of_range);
+      }
+
+      template <typename Int>
+      SEMVER_CONSTEXPR from_chars_result number(Int& out) noexcept {
+        std::uint64_t value = 0;
+        if (const auto res = varint(value); !res) {
+          return res;
+        }
+        if (!number_in_range<Int>(value)) {
+          return failure(current - 1, std::errc::result_out_of_range);
+        }
+        out = static_cast<Int>(value);
+        return success(current);
+      }
+
+      SEMVER_CONSTEXPR from_chars_result text(std::size_t length, std::string_view& out) noexcept {
+        if (static_cast<std::size_t>(last - current) < length) {
+          return failure(last);
+        }
+        out = std::string_view{ current, length };
+        current += length;
+        return success(current);
+      }
+
+      SEMVER_CONSTEXPR const char* position() const noexcept { return current; }
+    };
+
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static void write(writer& out, const version<I1, I2, I3>& v) noexcept {
+      out.varint(static_cast<std::uint64_t>(v.major_));
+      out.varint(static_cast<std::uint64_t>(v.minor_));
+      out.varint(static_cast<std::uint64_t>(v.patch_));
+      out.varint((v.prerelease_identifiers.size() << 1) | static_cast<std::size_t>(!v.build_metadata_.empty()));
+      for (const auto& identifier : v.prerelease_identifiers) {
+        out.varint((identifier.identifier.size() << 1) | static_cast<std::size_t>(identifier.type == prerelease_identifier_type::numeric));
+        out.text(identifier.identifier);
+      }
+      if (!v.build_metadata_.empty()) {
+        out.varint(v.build_metadata_.size());
+        out.text(v.build_metadata_);
+      }
     }
-  private:
-    std::vector<range_comparator<I1, I2, I3>> ranges_comparators;
 
-    SEMVER_CONSTEXPR bool match_at_least_one_comparator_with_prerelease(const version<I1, I2, I3>& v) const noexcept {
-      if (v.prerelease_tag().empty()) {
-        return true;
+    // The text is validated as strictly as parse would, so a decoded version is always one parse could produce.
+    template <typename I1, typename I2, typename I3>
+    SEMVER_CONSTEXPR static from_chars_result read(reader& in, version<I1, I2, I3>& out) {
+      I1 major = 0;
+      I2 minor = 0;
+      I3 patch = 0;
+      std::uint64_t header = 0;
+      if (const auto res = in.number(major); !res) {
+        return res;
+      }
+      if (const auto res = in.number(minor); !res) {
+        return res;
+      }
+      if (const auto res = in.number(patch); !res) {
+        return res;
+      }
+      if (const auto res = in.varint(header); !res) {
+        return res;
       }
 
-      return std::any_of(ranges_comparators.begin(), ranges_comparators.end(), [&](const auto& ranges_comparator) {
-        const bool has_prerelease = !ranges_comparator.get_version().prerelease_tag().empty();
-        const bool equal_without_prerelease = detail::compare_parsed(v, ranges_comparator.get_version(), version_compare_option::exclude_prerelease) == 0;
-        return has_prerelease && equal_without_prerelease;
-      });
+      out.major_ = major;
+      out.minor_ = minor;
+      out.patch_ = patch;
+      out.prerelease_tag_.clear();
+      out.build_metadata_.clear();
+
+      const std::uint64_t identifier_count = header >> 1;
+      if (identifier_count > static_cast<std::uint64_t>(in.last - in.current)) {
+        return failure(in.position());
+      }
+      out.prerelease_identifiers.resize(static_cast<std::size_t>(identifier_count));
+      for (auto& identifier : out.prerelease_identifiers) {
+        const char* first = in.position();
+        std::uint64_t length = 0;
+        std::string_view text;
+        if (const auto res = in.varint(length); !res) {
+          return res;
+        }
+        if (const auto res = in.text(static_cast<std::size_t>(length >> 1), text); !res) {
+          return res;
+        }
+
+        version_scanner scanner{ text };
+        std::string_view scanned;
+        bool numeric = false;
+        if (!scanner.scan_prerelease_identifier(scanned, numeric) || !scanner.is_eol() || numeric != ((length & 1) != 0)) {
+          return failure(first);
+        }
+
+        identifier.type = numeric ? prerelease_identifier_type::numeric : prerelease_identifier_type::alphanumeric;
+        identifier.identifier.assign(text.data(), text.size());
+        if (!out.prerelease_tag_.empty()) {
+          out.prerelease_tag_.push_back('.');
+        }
+        out.prerelease_tag_.append(text.data(), text.size());
+      }
+
+      if ((header & 1) != 0) {
+        const char* first = in.position();
+        std::uint64_t length = 0;
+        std::string_view text;
+        if (const auto res = in.varint(length); !res) {
+          return res;
+        }
+        if (const auto res = in.text(static_cast<std::size_t>(length), text); !res) {
+          return res;
+        }
+
+        version_scanner scanner{ text };
+        if (!scanner.scan_build_metadata() || !scanner.is_eol()) {
+          return failure(first);
+        }
+        out.build_metadata_.assign(text.data(), text.size());
+      }
+
+      out.hash_ = hash_version(out.major_, out.minor_, out.patch_, out.prerelease_tag_);
+      return success(in.position());
     }
   };
+} // namespace semver::detail
+
+// Writes the binary encoding of the version, see detail::binary_codec for the format.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR to_chars_result serialize(char* first, char* last, const version<I1, I2, I3>& v) noexcept {
+  return detail::binary_codec::write(first, last, v);
+}
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR to_chars_result serialize(char* first, char* last, const range_set<I1, I2, I3>& range) noexcept {
+  return detail::binary_codec::write(first, last, range);
+}
+
+// Reads one encoded value from the front of the buffer, `ptr` is where the next one starts.
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR from_chars_result deserialize(const char* first, const char* last, version<I1, I2, I3>& out) {
+  return detail::binary_codec::read(first, last, out);
+}
+
+template <typename I1, typename I2, typename I3>
+SEMVER_CONSTEXPR from_chars_result deserialize(const char* first, const char* last, range_set<I1, I2, I3>& out) {
+  return detail::binary_codec::read(first, last, out);
 }
 
+// Versions and range sets that live in constant expressions: they only refer to text they are given,
+// so they need no allocation and work even without a constexpr std::string.
 template <typename I1 = int, typename I2 = int, typename I3 = int>
-class range_set {
+class static_version {
 public:
-  friend class detail::range_parser;
+  constexpr static_version() = default;
 
-  SEMVER_CONSTEXPR bool contains(const version<I1, I2, I3>& v, version_compare_option option = version_compare_option::exclude_prerelease) noexcept {
-    return std::any_of(ranges.begin(), ranges.end(), [&](const auto& range) {
-      return range.contains(v, option);
-    });
-  }
+  constexpr static_version(I1 major, I2 minor, I3 patch, std::string_view prerelease_tag = {}, std::string_view build_metadata = {}) noexcept
+    : major_{major}, minor_{minor}, patch_{patch}, prerelease_tag_{prerelease_tag}, build_metadata_{build_metadata} {}
+
+  constexpr I1 major() const noexcept { return major_; }
+  constexpr I2 minor() const noexcept { return minor_; }
+  constexpr I3 patch() const noexcept { return patch_; }
+
+  constexpr std::string_view prerelease_tag() const noexcept { return prerelease_tag_; }
+  constexpr std::string_view build_metadata() const noexcept { return build_metadata_; }
+
+  [[nodiscard]] friend constexpr bool operator==(const static_version& lhs, const static_version& rhs) noexcept { return compare(lhs, rhs) == 0; }
+  [[nodiscard]] friend constexpr bool operator!=(const static_version& lhs, const static_version& rhs) noexcept { return compare(lhs, rhs) != 0; }
+  [[nodiscard]] friend constexpr bool operator<(const static_version& lhs, const static_version& rhs) noexcept { return compare(lhs, rhs) < 0; }
+  [[nodiscard]] friend constexpr bool operator<=(const static_version& lhs, const static_version& rhs) noexcept { return compare(lhs, rhs) <= 0; }
+  [[nodiscard]] friend constexpr bool operator>(const static_version& lhs, const static_version& rhs) noexcept { return compare(lhs, rhs) > 0; }
+  [[nodiscard]] friend constexpr bool operator>=(const static_version& lhs, const static_version& rhs) noexcept { return compare(lhs, rhs) >= 0; }
 
 private:
-  std::vector<detail::range<I1, I2, I3>> ranges;
+  I1 major_ = 0;
+  I2 minor_ = 1;
+  I3 patch_ = 0;
+  std::string_view prerelease_tag_;
+  std::string_view build_metadata_;
+
+  constexpr static int compare(const static_version& lhs, const static_version& rhs) noexcept;
 };
 
 namespace detail {
-  class range_parser {
-  public:
-    SEMVER_CONSTEXPR explicit range_parser(token_stream stream) noexcept : stream(std::move(stream)) {}
+  // Prerelease precedence of two dot-separated tags, both already validated.
+  constexpr int compare_prerelease_tag(std::string_view lhs, std::string_view rhs) noexcept {
+    if (lhs.empty() || rhs.empty()) {
+      // a release has a higher precedence than a prerelease
+      return static_cast<int>(lhs.empty()) - static_cast<int>(rhs.empty());
+    }
 
-    template <typename I1, typename I2, typename I3>
-    SEMVER_CONSTEXPR from_chars_result parse(range_set<I1, I2, I3>& out) noexcept {
-      std::vector<range<I1, I2, I3>> ranges;
+    version_scanner lhs_scanner{ lhs };
+    version_scanner rhs_scanner{ rhs };
+    while (true) {
+      std::string_view lhs_identifier;
+      std::string_view rhs_identifier;
+      bool lhs_numeric = false;
+      bool rhs_numeric = false;
+      static_cast<void>(lhs_scanner.scan_prerelease_identifier(lhs_identifier, lhs_numeric));
+      static_cast<void>(rhs_scanner.scan_prerelease_identifier(rhs_identifier, rhs_numeric));
+
+      if (const int result = compare_prerelease_identifier(lhs_identifier, lhs_numeric, rhs_identifier, rhs_numeric); result != 0) {
+        return result;
+      }
 
-      do {
+      const bool lhs_more = lhs_scanner.advance_if_match('.');
+      const bool rhs_more = rhs_scanner.advance_if_match('.');
+      if (!lhs_more || !rhs_more) {
+        return static_cast<int>(lhs_more) - static_cast<int>(rhs_more);
+      }
+    }
+  }
+
+  template <typename I1, typename I2, typename I3>
+  constexpr int compare_static(const static_version<I1, I2, I3>& lhs, const static_version<I1, I2, I3>& rhs, version_compare_option option) noexcept {
+    if (lhs.major() != rhs.major()) {
+      return lhs.major() < rhs.major() ? -1 : 1;
+    }
+    if (lhs.minor() != rhs.minor()) {
+      return lhs.minor() < rhs.minor() ? -1 : 1;
+    }
+    if (lhs.patch() != rhs.patch()) {
+      return lhs.patch() < rhs.patch() ? -1 : 1;
+    }
+    return option == version_compare_option::include_prerelease ? compare_prerelease_tag(lhs.prerelease_tag(), rhs.prerelease_tag()) : 0;
+  }
+} // namespace semver::detail
+
+template <typename I1, typename I2, typename I3>
+constexpr int static_version<I1, I2, I3>::compare(const static_version& lhs, const static_version& rhs) noexcept {
+  return detail::compare_static(lhs, rhs, version_compare_option::include_prerelease);
+}
+
+namespace detail {
+  // Scans a whole version from the front of `scanner`, leaving whatever follows it.
+  template <typename I1, typename I2, typename I3>
+  constexpr from_chars_result scan_version(version_scanner& scanner, static_version<I1, I2, I3>& out) noexcept {
+    I1 major = 0;
+    I2 minor = 0;
+    I3 patch = 0;
 
-        detail::range<I1, I2, I3> range;
-        if (const auto res = parse_range(range); !res) {
+    if (const auto res = scanner.scan_number(major); !res) {
+      return res;
+    }
+    if (!scanner.advance_if_match('.')) {
+      return failure(scanner.position());
+    }
+    if (const auto res = scanner.scan_number(minor); !res) {
+      return res;
+    }
+    if (!scanner.advance_if_match('.')) {
+      return failure(scanner.position());
+    }
+    if (const auto res = scanner.scan_number(patch); !res) {
+      return res;
+    }
+
+    std::string_view prerelease_tag;
+    if (scanner.advance_if_match('-')) {
+      const char* first = scanner.position();
+      do {
+        std::string_view identifier;
+        bool numeric = false;
+        if (const auto res = scanner.scan_prerelease_identifier(identifier, numeric); !res) {
           return res;
         }
+      } while (scanner.advance_if_match('.'));
+      prerelease_tag = std::string_view{first, static_cast<std::size_t>(scanner.position() - first)};
+    }
 
-        ranges.push_back(range);
-        skip_whitespaces();
+    std::string_view build_metadata;
+    if (scanner.advance_if_match('+')) {
+      const char* first = scanner.position();
+      if (const auto res = scanner.scan_build_metadata(); !res) {
+        return res;
+      }
+      build_metadata = std::string_view{first, static_cast<std::size_t>(scanner.position() - first)};
+    }
+
+    out = { major, minor, patch, prerelease_tag, build_metadata };
+    return success(scanner.position());
+  }
+} // namespace semver::detail
+
+// Views into `str`, which must outlive the version.
+template <typename I1, typename I2, typename I3>
+constexpr from_chars_result parse(std::string_view str, static_version<I1, I2, I3>& out) noexcept {
+  detail::version_scanner scanner{ str };
+  static_version<I1, I2, I3> result;
+  if (const auto res = detail::scan_version(scanner, result); !res) {
+    return res;
+  }
+  if (!scanner.is_eol()) {
+    return detail::failure(scanner.position());
+  }
 
-      } while (stream.advanceIfMatch(token_type::logical_or));
+  out = result;
+  return detail::success(scanner.position());
+}
 
-      out.ranges = std::move(ranges);
+namespace detail {
+  constexpr bool is_version_symbol(char c) noexcept {
+    return is_digit(c) || is_letter(c) || c == '.' || c == '-' || c == '+';
+  }
 
-      return success(stream.peek().lexeme);
+  // The version starting at the digit `first`, if it is a whole token of `[first_text, last_text)`:
+  // not glued to letters, digits or dots before it, and ending before other text or trailing punctuation.
+  // `run_end` is the end of the last run of version symbols scanned; every candidate inside that run
+  // ends with it, so a long run such as `1.1-1.1-...` is scanned once, not once per candidate.
+  template <typename I1, typename I2, typename I3>
+  constexpr std::string_view match_version(const char* first_text, const char* first, const char* last_text, const char*& run_end,
+                                           static_version<I1, I2, I3>& out) noexcept {
+    const char* before = first;
+    if (before != first_text && before[-1] == 'v') {
+      --before;
+    }
+    if (before != first_text && (is_digit(before[-1]) || is_letter(before[-1]) || before[-1] == '.')) {
+      return {};
     }
-    
-  private:
-    token_stream stream;
 
-    template <typename I1, typename I2, typename I3>
-    SEMVER_CONSTEXPR from_chars_result parse_range(detail::range<I1, I2, I3>& out) noexcept {
-      do {
-        skip_whitespaces();
+    if (first >= run_end) {
+      run_end = first;
+      while (run_end != last_text && is_version_symbol(*run_end)) {
+        ++run_end;
+      }
+    }
 
-        if (const auto res = parse_range_comparator(out.ranges_comparators); !res) {
-          return res;
-        }
+    const char* last = run_end;
+    while (last[-1] == '.' || last[-1] == '-' || last[-1] == '+') {
+      --last;
+    }
 
-        skip_whitespaces();
+    const std::string_view token{ first, static_cast<std::size_t>(last - first) };
+    return parse(token, out) ? token : std::string_view{};
+  }
+} // namespace semver::detail
 
-      } while (stream.check(token_type::range_operator) || stream.check(token_type::digit));
-      
-      return success(stream.peek().lexeme);
+// Finds the versions in free text such as logs or manifests, optionally written with a leading `v`.
+// Calls `f(std::string_view match, const static_version<I1, I2, I3>& v)` for each, in order, where `match`
+// views `text` without the `v`; returns how many were found.
+template <typename I1 = int, typename I2 = int, typename I3 = int, typename F>
+std::size_t find_all(std::string_view text, F&& f) {
+  const char* const first = text.data();
+  const char* const last = first + text.size();
+  std::size_t count = 0;
+
+  // memchr is vectorized by the C library; a dot between two digits is rare in text, a version always has one
+  const char* current = first;
+  const char* run_end = first;
+  while (current != last) {
+    const auto* dot = static_cast<const char*>(std::memchr(current, '.', static_cast<std::size_t>(last - current)));
+    if (dot == nullptr) {
+      break;
+    }
+    current = dot + 1;
+    if (dot == first || current == last || !detail::is_digit(dot[-1]) || !detail::is_digit(*current)) {
+      continue;
     }
 
-    template <typename I1, typename I2, typename I3>
-    SEMVER_CONSTEXPR from_chars_result parse_range_comparator(std::vector<detail::range_comparator<I1, I2, I3>>& out) noexcept {
-      range_operator op = range_operator::equal;
-      token token;
-      if (stream.advanceIfMatch(token, token_type::range_operator)) {
-        op = std::get<range_operator>(token.value);
+    const char* start = dot - 1;
+    while (start != first && detail::is_digit(start[-1])) {
+      --start;
+    }
+
+    static_version<I1, I2, I3> v;
+    if (const auto match = detail::match_version(first, start, last, run_end, v); !match.empty()) {
+      f(match, v);
+      ++count;
+      current = match.data() + match.size();
+    }
+  }
+  return count;
+}
+
+namespace detail {
+  template <std::size_t Capacity, typename I1, typename I2, typename I3>
+  class static_range_parser;
+}
+
+// Up to `Capacity` comparators, grouped in ranges joined by `||`.
+template <std::size_t Capacity, typename I1 = int, typename I2 = int, typename I3 = int>
+class static_range_set {
+public:
+  template <std::size_t, typename, typename, typename>
+  friend class detail::static_range_parser;
+
+  constexpr bool contains(const static_version<I1, I2, I3>& v, version_compare_option option = version_compare_option::exclude_prerelease) const noexcept {
+    std::size_t first = 0;
+    for (std::size_t r = 0; r < range_count_; ++r) {
+      const std::size_t last = range_ends_[r];
+      if (contains(v, option, first, last)) {
+        return true;
       }
+      first = last;
+    }
+    return false;
+  }
 
-      skip_whitespaces();
+private:
+  struct comparator {
+    static_version<I1, I2, I3> v;
+    detail::range_operator op = detail::range_operator::equal;
 
-      version<I1, I2, I3> ver;
-      version_parser parser{ stream };
-      if (const auto res = parser.parse(ver); !res) {
-        return res;
+    constexpr const static_version<I1, I2, I3>& get_version() const noexcept { return v; }
+
+    constexpr int compare(const static_version<I1, I2, I3>& other, version_compare_option option) const noexcept {
+      return detail::compare_static(other, v, option);
+    }
+
+    constexpr bool accepts(int result) const noexcept { return detail::accepts(op, result); }
+  };
+
+  comparator comparators_[Capacity] = {};
+  std::size_t range_ends_[Capacity] = {};
+  std::size_t comparator_count_ = 0;
+  std::size_t range_count_ = 0;
+
+  constexpr bool contains(const static_version<I1, I2, I3>& v, version_compare_option option, std::size_t first, std::size_t last) const noexcept {
+    return detail::comparators_contain(comparators_ + first, comparators_ + last, v, option);
+  }
+};
+
+namespace detail {
+  // Fills a static_range_set from what range_scanner reads, failing with value_too_large past `Capacity`.
+  template <std::size_t Capacity, typename I1, typename I2, typename I3>
+  class static_range_parser {
+  public:
+    constexpr explicit static_range_parser(static_range_set<Capacity, I1, I2, I3>& out) noexcept : out_{out} {}
+
+    constexpr std::errc add(const desugared_range<I1, I2, I3>& range, const written_version<I1, I2, I3>& lower, const written_version<I1, I2, I3>& upper) noexcept {
+      if (out_.comparator_count_ + range.size > Capacity) {
+        return std::errc::value_too_large;
       }
 
-      out.emplace_back(ver, op);
-      return success(stream.peek().lexeme);
+      for (std::size_t i = 0; i < range.size; ++i) {
+        const auto& c = range.comparators[i];
+        static_version<I1, I2, I3> v{ c.major, c.minor, c.patch, c.zero_prerelease ? "0" : "" };
+        if (c.as_written) {
+          const bool is_upper = c.op == range_operator::less || c.op == range_operator::less_or_equal;
+          const auto& written = is_upper ? upper : lower;
+          v = { written.partial.major, written.partial.minor, written.partial.patch, written.prerelease_tag, written.build_metadata };
+        }
+        out_.comparators_[out_.comparator_count_++] = { v, c.op };
+      }
+      return std::errc{};
     }
 
-    SEMVER_CONSTEXPR void skip_whitespaces() noexcept {
-      while (stream.advanceIfMatch(token_type::space)) {
-        ;
+    constexpr std::errc next_range() noexcept {
+      if (out_.range_count_ == Capacity) {
+        return std::errc::value_too_large;
       }
+      out_.range_ends_[out_.range_count_++] = out_.comparator_count_;
+      return std::errc{};
     }
+
+  private:
+    static_range_set<Capacity, I1, I2, I3>& out_;
   };
 } // namespace semver::detail
 
+// Views into `str`, which must outlive the range set.
+template <std::size_t Capacity, typename I1, typename I2, typename I3>
+constexpr from_chars_result parse(std::string_view str, static_range_set<Capacity, I1, I2, I3>& out) noexcept {
+  out = {};
+  detail::static_range_parser<Capacity, I1, I2, I3> parser{ out };
+  return detail::range_scanner<I1, I2, I3>{ str }.parse(parser);
+}
 
-template <typename I1, typename I2, typename I3>
-SEMVER_CONSTEXPR from_chars_result parse(std::string_view str, range_set<I1, I2, I3>& out) {
-  detail::token_stream token_stream;
-  const from_chars_result result =  detail::lexer{ str }.scan_tokens(token_stream);
-  if (!result) {
-    return result;
+template <std::size_t Capacity, typename I1, typename I2, typename I3>
+constexpr bool satisfies(const static_version<I1, I2, I3>& v, const static_range_set<Capacity, I1, I2, I3>& range,
+                         version_compare_option option = version_compare_option::exclude_prerelease) noexcept {
+  return range.contains(v, option);
+}
+
+#if __cpp_nontype_template_args >= 201911L && __cpp_consteval >= 201811L
+// A string literal usable as a template argument.
+template <std::size_t N>
+struct fixed_string {
+  char data[N] = {};
+
+  constexpr fixed_string(const char (&str)[N]) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+      data[i] = str[i];
+    }
   }
 
-  return detail::range_parser{ std::move(token_stream) }.parse(out);
+  constexpr std::size_t size() const noexcept { return N - 1; }
+
+  constexpr std::string_view view() const noexcept { return { data, N - 1 }; }
+};
+
+namespace detail {
+  // Not constexpr, so a literal that fails to parse fails to compile at the call.
+  inline void invalid_version_literal() noexcept {}
+  inline void invalid_range_literal() noexcept {}
 }
 
+inline namespace literals {
+  template <fixed_string S>
+  consteval static_version<> operator""_sv() noexcept {
+    static_version<> v;
+    if (!parse(S.view(), v)) {
+      detail::invalid_version_literal();
+    }
+    return v;
+  }
+
+  // Every character may add at most two comparators.
+  template <fixed_string S>
+  consteval static_range_set<2 * S.size() + 2> operator""_sr() noexcept {
+    static_range_set<2 * S.size() + 2> r;
+    if (const auto result = parse(S.view(), r); !result || result.ptr != S.view().data() + S.view().size()) {
+      detail::invalid_range_literal();
+    }
+    return r;
+  }
+} // namespace semver::literals
+#endif
+
 #undef SEMVER_CONSTEXPR
 
 } // namespace semver
 
+namespace std {
+
+template <typename I1, typename I2, typename I3>
+struct hash<semver::version<I1, I2, I3>> {
+  std::size_t operator()(const semver::version<I1, I2, I3>& v) const noexcept {
+    return v.hash();
+  }
+};
+
+template <typename I1, typename I2, typename I3>
+struct hash<semver::core_version<I1, I2, I3>> {
+  std::size_t operator()(const semver::core_version<I1, I2, I3>& v) const noexcept {
+    return v.hash();
+  }
+};
+
+} // namespace std
+
 #if defined(__clang__)
 #  pragma clang diagnostic pop
 #endif
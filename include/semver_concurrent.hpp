@@ -0,0 +1,372 @@
+//          _____                            _   _
+//         / ____|                          | | (_)
+//        | (___   ___ _ __ ___   __ _ _ __ | |_ _  ___
+//         \___ \ / _ \ '_ ` _ \ / _` | '_ \| __| |/ __|
+//         ____) |  __/ | | | | | (_| | | | | |_| | (__
+//        |_____/ \___|_| |_| |_|\__,_|_| |_|\__|_|\___|
+// __      __           _             _                _____
+// \ \    / /          (_)           (_)              / ____|_     _
+//  \ \  / /__ _ __ ___ _  ___  _ __  _ _ __   __ _  | |   _| |_ _| |_
+//   \ \/ / _ \ '__/ __| |/ _ \| '_ \| | '_ \ / _` | | |  |_   _|_   _|
+//    \  /  __/ |  \__ \ | (_) | | | | | | | | (_| | | |____|_|   |_|
+//     \/ \___|_|  |___/_|\___/|_| |_|_|_| |_|\__, |  \_____|
+// https://github.com/Neargye/semver           __/ |
+// version 1.0.0                              |___/
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2025 Daniil Goncharov <neargye@gmail.com>.
+// Copyright (c) 2020 - 2025 Alexander Gorbunov <naratzul@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NEARGYE_SEMANTIC_VERSIONING_CONCURRENT_HPP
+#define NEARGYE_SEMANTIC_VERSIONING_CONCURRENT_HPP
+
+#include "semver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace semver {
+
+namespace detail {
+
+// One shard of parse_cache: a fixed number of entries indexed by a linear-probing table
+// and evicted in CLOCK order, so the memory footprint never grows past the capacity.
+template <typename T>
+class parse_cache_shard {
+public:
+  explicit parse_cache_shard(std::size_t capacity) : capacity_{capacity}, entries_{new entry[capacity]} {
+    std::size_t slots = 1;
+    while (slots < capacity * 2) {
+      slots *= 2;
+    }
+    slots_.assign(slots, empty_slot);
+  }
+
+  bool find(std::string_view key, std::size_t hash, std::shared_ptr<const T>& out, std::size_t& length) const {
+    std::shared_lock lock{mutex_};
+    const std::size_t slot = find_slot(key, hash);
+    if (slots_[slot] == empty_slot) {
+      return false;
+    }
+
+    const entry& e = entries_[slots_[slot]];
+    e.referenced.store(true, std::memory_order_relaxed);
+    out = e.value;
+    length = e.length;
+    return true;
+  }
+
+  void insert(std::string_view key, std::size_t hash, std::shared_ptr<const T>& value, std::size_t& length) {
+    std::unique_lock lock{mutex_};
+    std::size_t slot = find_slot(key, hash);
+    if (slots_[slot] != empty_slot) {
+      // Another thread parsed the same string first, share its result.
+      const entry& e = entries_[slots_[slot]];
+      value = e.value;
+      length = e.length;
+      return;
+    }
+
+    std::uint32_t index = static_cast<std::uint32_t>(size_);
+    if (size_ == capacity_) {
+      index = evict();
+      slot = find_slot(key, hash);
+    } else {
+      ++size_;
+    }
+
+    entry& e = entries_[index];
+    e.key.assign(key.data(), key.size());
+    e.hash = hash;
+    e.value = value;
+    e.length = length;
+    e.referenced.store(false, std::memory_order_relaxed);
+    slots_[slot] = index;
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock{mutex_};
+    return size_;
+  }
+
+  void clear() {
+    std::unique_lock lock{mutex_};
+    for (std::size_t i = 0; i < size_; ++i) {
+      entries_[i].value.reset();
+      entries_[i].key.clear();
+    }
+    slots_.assign(slots_.size(), empty_slot);
+    size_ = 0;
+    hand_ = 0;
+  }
+
+private:
+  static constexpr std::uint32_t empty_slot = std::numeric_limits<std::uint32_t>::max();
+
+  struct entry {
+    std::string key;
+    std::size_t hash = 0;
+    std::size_t length = 0;
+    std::shared_ptr<const T> value;
+    mutable std::atomic<bool> referenced{false};
+  };
+
+  mutable std::shared_mutex mutex_;
+  std::size_t capacity_;
+  std::size_t size_ = 0;
+  std::size_t hand_ = 0;
+  std::unique_ptr<entry[]> entries_;
+  std::vector<std::uint32_t> slots_;
+
+  std::size_t find_slot(std::string_view key, std::size_t hash) const noexcept {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t slot = hash & mask;
+    while (slots_[slot] != empty_slot) {
+      const entry& e = entries_[slots_[slot]];
+      if (e.hash == hash && e.key == key) {
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  // Gives every entry a second chance before it is dropped.
+  std::uint32_t evict() {
+    while (entries_[hand_].referenced.exchange(false, std::memory_order_relaxed)) {
+      hand_ = (hand_ + 1) % capacity_;
+    }
+
+    const auto index = static_cast<std::uint32_t>(hand_);
+    hand_ = (hand_ + 1) % capacity_;
+
+    entry& e = entries_[index];
+    erase_slot(find_slot(e.key, e.hash));
+    e.value.reset();
+    return index;
+  }
+
+  // Backward-shift deletion keeps probe sequences intact without tombstones.
+  void erase_slot(std::size_t slot) noexcept {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t next = (slot + 1) & mask;
+    while (slots_[next] != empty_slot) {
+      const std::size_t home = entries_[slots_[next]].hash & mask;
+      if (((next - home) & mask) >= ((next - slot) & mask)) {
+        slots_[slot] = slots_[next];
+        slot = next;
+      }
+      next = (next + 1) & mask;
+    }
+    slots_[slot] = empty_slot;
+  }
+};
+
+} // namespace semver::detail
+
+// Thread-safe, bounded cache of parsed versions or range sets keyed by the raw string.
+// Values are shared and immutable, so a hot string is parsed once for all threads.
+template <typename T>
+class parse_cache {
+public:
+  explicit parse_cache(std::size_t capacity = 4096, std::size_t shards = 16) {
+    shards = shards == 0 ? 1 : shards;
+    const std::size_t shard_capacity = capacity / shards + (capacity % shards == 0 ? 0 : 1);
+    shards_.reserve(shards);
+    for (std::size_t i = 0; i < shards; ++i) {
+      shards_.push_back(std::make_unique<detail::parse_cache_shard<T>>(shard_capacity == 0 ? 1 : shard_capacity));
+    }
+  }
+
+  from_chars_result parse(std::string_view str, std::shared_ptr<const T>& out) {
+    const std::size_t hash = std::hash<std::string_view>{}(str);
+    // Shards are picked by the high bits, slots inside a shard by the low ones.
+    auto& shard = *shards_[static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> 40) % shards_.size()];
+
+    std::size_t length = 0;
+    if (shard.find(str, hash, out, length)) {
+      return detail::success(str.data() + length);
+    }
+
+    auto value = std::make_shared<T>();
+    const from_chars_result result = semver::parse(str, *value);
+    if (!result) {
+      return result;
+    }
+
+    out = std::move(value);
+    length = static_cast<std::size_t>(result.ptr - str.data());
+    shard.insert(str, hash, out, length);
+    return detail::success(str.data() + length);
+  }
+
+  std::size_t size() const {
+    std::size_t result = 0;
+    for (const auto& shard : shards_) {
+      result += shard->size();
+    }
+    return result;
+  }
+
+  void clear() {
+    for (auto& shard : shards_) {
+      shard->clear();
+    }
+  }
+
+private:
+  std::vector<std::unique_ptr<detail::parse_cache_shard<T>>> shards_;
+};
+
+namespace detail {
+  // Calls a task for every index in [0, count) on up to `threads` threads, this one included,
+  // which take indices from a shared counter; `threads == 0` uses every hardware thread.
+  // `make_task()` is called once per thread, so each task may keep its own scratch buffers.
+  // The first exception thrown stops the other threads and is rethrown here.
+  template <typename MakeTask>
+  void parallel_for(std::size_t count, unsigned threads, MakeTask&& make_task) {
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto worker = [&] {
+      try {
+        auto task = make_task();
+        for (std::size_t i = next++; i < count; i = next++) {
+          task(i);
+        }
+      } catch (...) {
+        std::lock_guard lock{error_mutex};
+        if (!error) {
+          error = std::current_exception();
+        }
+        next = count;
+      }
+    };
+
+    if (threads == 0) {
+      threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(count, 1)));
+
+    std::vector<std::thread> pool;
+    try {
+      pool.reserve(threads - 1);
+      for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+      }
+    } catch (...) {
+      // the threads that did start still finish the work
+    }
+
+    worker();
+    for (auto& thread : pool) {
+      thread.join();
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+} // namespace semver::detail
+
+// Row-major bitmap telling which range sets (rows) contain which versions (columns).
+// Each row starts on a fresh 64-bit word.
+class match_matrix {
+public:
+  match_matrix() = default;
+
+  match_matrix(std::size_t rows, std::size_t columns) : rows_{rows}, columns_{columns}, stride_{(columns + 63) / 64}, words_(rows * stride_) {}
+
+  std::size_t rows() const noexcept { return rows_; }
+
+  std::size_t columns() const noexcept { return columns_; }
+
+  // Words per row.
+  std::size_t stride() const noexcept { return stride_; }
+
+  bool test(std::size_t row, std::size_t column) const noexcept {
+    return (words_[row * stride_ + column / 64] >> (column % 64)) & 1U;
+  }
+
+  const std::uint64_t* row(std::size_t row) const noexcept { return words_.data() + row * stride_; }
+
+  std::uint64_t* row(std::size_t row) noexcept { return words_.data() + row * stride_; }
+
+private:
+  std::size_t rows_ = 0;
+  std::size_t columns_ = 0;
+  std::size_t stride_ = 0;
+  std::vector<std::uint64_t> words_;
+};
+
+// Checks every range set against every version of the table, with the same result as
+// range_set::contains. The matrix is cut in tiles of ranges by versions that threads take
+// from a shared counter, tiles of the same versions first so their columns stay in cache.
+// `threads == 0` uses every hardware thread.
+template <typename I1, typename I2, typename I3>
+match_matrix match(const version_table<I1, I2, I3>& table, const std::vector<range_set<I1, I2, I3>>& ranges,
+                   version_compare_option option = version_compare_option::exclude_prerelease, unsigned threads = 0) {
+  constexpr std::size_t tile_rows = 32;
+  constexpr std::size_t tile_columns = 4096; // a multiple of 64, so tiles never share a word
+
+  match_matrix result{ranges.size(), table.size()};
+  const std::size_t row_tiles = (ranges.size() + tile_rows - 1) / tile_rows;
+  const std::size_t column_tiles = (table.size() + tile_columns - 1) / tile_columns;
+  const std::size_t tiles = row_tiles * column_tiles;
+
+  detail::parallel_for(tiles, threads, [&] {
+    return [&, mask = std::vector<std::uint8_t>(tile_columns), scratch = std::vector<std::uint8_t>(tile_columns)](std::size_t tile) mutable {
+      const std::size_t first_column = tile / row_tiles * tile_columns;
+      const std::size_t last_column = std::min(first_column + tile_columns, table.size());
+      const std::size_t first_row = tile % row_tiles * tile_rows;
+      const std::size_t last_row = std::min(first_row + tile_rows, ranges.size());
+
+      for (std::size_t row = first_row; row < last_row; ++row) {
+        detail::filter_releases(ranges[row], table, first_column, last_column, mask.data(), scratch.data());
+        detail::filter_prereleases(ranges[row], table, first_column, last_column, mask.data(), option);
+
+        std::uint64_t* words = result.row(row) + first_column / 64;
+        for (std::size_t i = 0; i < last_column - first_column; ++i) {
+          words[i / 64] |= static_cast<std::uint64_t>(mask[i]) << (i % 64);
+        }
+      }
+    };
+  });
+  return result;
+}
+
+} // namespace semver
+
+#endif // NEARGYE_SEMANTIC_VERSIONING_CONCURRENT_HPP
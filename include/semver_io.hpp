@@ -0,0 +1,701 @@
+//          _____                            _   _
+//         / ____|                          | | (_)
+//        | (___   ___ _ __ ___   __ _ _ __ | |_ _  ___
+//         \___ \ / _ \ '_ ` _ \ / _` | '_ \| __| |/ __|
+//         ____) |  __/ | | | | | (_| | | | | |_| | (__
+//        |_____/ \___|_| |_| |_|\__,_|_| |_|\__|_|\___|
+// __      __           _             _                _____
+// \ \    / /          (_)           (_)              / ____|_     _
+//  \ \  / /__ _ __ ___ _  ___  _ __  _ _ __   __ _  | |   _| |_ _| |_
+//   \ \/ / _ \ '__/ __| |/ _ \| '_ \| | '_ \ / _` | | |  |_   _|_   _|
+//    \  /  __/ |  \__ \ | (_) | | | | | | | | (_| | | |____|_|   |_|
+//     \/ \___|_|  |___/_|\___/|_| |_|_|_| |_|\__, |  \_____|
+// https://github.com/Neargye/semver           __/ |
+// version 1.0.0                              |___/
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2025 Daniil Goncharov <neargye@gmail.com>.
+// Copyright (c) 2020 - 2025 Alexander Gorbunov <naratzul@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#ifndef NEARGYE_SEMANTIC_VERSIONING_IO_HPP
+#define NEARGYE_SEMANTIC_VERSIONING_IO_HPP
+
+#include "semver.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define SEMVER_IO_POSIX
+#endif
+
+namespace semver {
+
+namespace detail {
+  // On-disk layout of a mapped_catalog, in the byte order of the machine that wrote it:
+  //
+  //   header | packages[package_count] | entries[entry_count] | string pool
+  //
+  // Packages are sorted by name and each owns a run of entries sorted by precedence.
+  // Names, prerelease tags and build metadata are (offset, length) slices of the string pool.
+  struct catalog_header {
+    char magic[8];
+    std::uint32_t byte_order;
+    std::uint32_t format;
+    std::uint64_t package_count;
+    std::uint64_t entry_count;
+    std::uint64_t packages_offset;
+    std::uint64_t entries_offset;
+    std::uint64_t pool_offset;
+    std::uint64_t pool_size;
+  };
+
+  struct catalog_package {
+    std::uint64_t name_offset;
+    std::uint64_t name_length;
+    std::uint64_t first;
+    std::uint64_t count;
+  };
+
+  struct catalog_entry {
+    std::uint64_t major_minor; // (major << 32) | minor, the first two numbers compare at once
+    std::uint32_t patch;
+    std::uint32_t prerelease_length; // 0 for a release
+    std::uint32_t prerelease_offset;
+    std::uint32_t build_offset;
+    std::uint32_t build_length;
+    std::uint32_t reserved;
+  };
+
+  inline constexpr char catalog_magic[8] = { 'S', 'E', 'M', 'V', 'E', 'R', 'C', 'T' };
+  inline constexpr std::uint32_t catalog_byte_order = 0x01020304;
+  inline constexpr std::uint32_t catalog_format = 1;
+
+  // Entries are not validated when a catalog is opened, so every slice is clamped to the pool instead.
+  inline std::string_view pool_slice(std::string_view pool, std::uint64_t offset, std::uint64_t length) noexcept {
+    if (offset > pool.size() || length > pool.size() - offset) {
+      return {};
+    }
+    return pool.substr(static_cast<std::size_t>(offset), static_cast<std::size_t>(length));
+  }
+
+  inline int compare_core(const catalog_entry& lhs, std::uint64_t major_minor, std::uint32_t patch) noexcept {
+    if (lhs.major_minor != major_minor) {
+      return lhs.major_minor < major_minor ? -1 : 1;
+    }
+    if (lhs.patch != patch) {
+      return lhs.patch < patch ? -1 : 1;
+    }
+    return 0;
+  }
+
+  template <typename I1, typename I2, typename I3>
+  int compare_entry(const catalog_entry& lhs, std::string_view pool, const version<I1, I2, I3>& rhs) noexcept {
+    const auto major = static_cast<std::uint64_t>(rhs.major());
+    const auto minor = static_cast<std::uint64_t>(rhs.minor());
+    const auto patch = static_cast<std::uint64_t>(rhs.patch());
+    if (major > std::numeric_limits<std::uint32_t>::max() || minor > std::numeric_limits<std::uint32_t>::max() ||
+        patch > std::numeric_limits<std::uint32_t>::max()) {
+      return -1;
+    }
+
+    if (const int result = compare_core(lhs, (major << 32) | minor, static_cast<std::uint32_t>(patch)); result != 0) {
+      return result;
+    }
+    return compare_prerelease_tag(pool_slice(pool, lhs.prerelease_offset, lhs.prerelease_length), rhs.prerelease_tag());
+  }
+
+  // Orders the entries of one package for the searches of semver.hpp, as version_order does versions.
+  struct entry_order {
+    std::string_view pool;
+
+    int operator()(const catalog_entry& lhs, const catalog_entry& rhs, version_compare_option option) const noexcept {
+      if (const int result = compare_core(lhs, rhs.major_minor, rhs.patch); result != 0 || option == version_compare_option::exclude_prerelease) {
+        return result;
+      }
+      return compare_prerelease_tag(pool_slice(pool, lhs.prerelease_offset, lhs.prerelease_length), pool_slice(pool, rhs.prerelease_offset, rhs.prerelease_length));
+    }
+
+    // Ranges only bound entries with prerelease tags included.
+    template <typename I1, typename I2, typename I3>
+    int operator()(const catalog_entry& lhs, const version<I1, I2, I3>& rhs, version_compare_option) const noexcept {
+      return compare_entry(lhs, pool, rhs);
+    }
+  };
+} // namespace semver::detail
+
+// A version stored in a mapped_catalog, viewing the mapped memory.
+class mapped_version {
+public:
+  mapped_version(const detail::catalog_entry& entry, std::string_view pool) noexcept : entry_{&entry}, pool_{pool} {}
+
+  std::uint32_t major() const noexcept { return static_cast<std::uint32_t>(entry_->major_minor >> 32); }
+  std::uint32_t minor() const noexcept { return static_cast<std::uint32_t>(entry_->major_minor); }
+  std::uint32_t patch() const noexcept { return entry_->patch; }
+
+  std::string_view prerelease_tag() const noexcept { return detail::pool_slice(pool_, entry_->prerelease_offset, entry_->prerelease_length); }
+  std::string_view build_metadata() const noexcept { return detail::pool_slice(pool_, entry_->build_offset, entry_->build_length); }
+
+  std::string to_string() const {
+    std::string result = std::to_string(major()) + '.' + std::to_string(minor()) + '.' + std::to_string(patch());
+    if (const auto prerelease = prerelease_tag(); !prerelease.empty()) {
+      result.append(1, '-').append(prerelease.data(), prerelease.size());
+    }
+    if (const auto build = build_metadata(); !build.empty()) {
+      result.append(1, '+').append(build.data(), build.size());
+    }
+    return result;
+  }
+
+private:
+  const detail::catalog_entry* entry_;
+  std::string_view pool_;
+};
+
+// Read-only catalog of many packages' versions, queried in place in a file written by catalog_writer.
+// Opening maps the file and checks the header and package table; entries are only read by queries.
+class mapped_catalog {
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  // The versions of one package in precedence order.
+  class package {
+  public:
+    std::string_view name() const noexcept { return detail::pool_slice(pool_, package_->name_offset, package_->name_length); }
+
+    std::size_t size() const noexcept { return static_cast<std::size_t>(package_->count); }
+
+    bool empty() const noexcept { return package_->count == 0; }
+
+    mapped_version operator[](std::size_t index) const noexcept { return { entries_[index], pool_ }; }
+
+    // Index of the highest version satisfying the range, or npos.
+    template <typename I1, typename I2, typename I3>
+    std::size_t max_satisfying(const range_set<I1, I2, I3>& range, version_compare_option option = version_compare_option::exclude_prerelease) const {
+      const auto* const last = entries_ + size();
+      const auto* result = last;
+      for (const auto& r : range.get_ranges()) {
+        const auto* it = detail::last_satisfying(entries_, last, r, option, detail::entry_order{ pool_ }, [&](const detail::catalog_entry& entry) {
+          return passes_gate(r, entry);
+        });
+        if (it != last && (result == last || result < it)) {
+          result = it;
+        }
+      }
+      return result == last ? npos : static_cast<std::size_t>(result - entries_);
+    }
+
+    // Appends the indices of all versions satisfying the range in ascending order.
+    template <typename I1, typename I2, typename I3>
+    void satisfying(const range_set<I1, I2, I3>& range, std::vector<std::size_t>& out, version_compare_option option = version_compare_option::exclude_prerelease) const {
+      const std::size_t offset = out.size();
+      for (const auto& r : range.get_ranges()) {
+        const auto [first, last] = rank_interval(r);
+        for (std::size_t i = first; i < last; ++i) {
+          if (option == version_compare_option::include_prerelease || passes_gate(r, entries_[i])) {
+            out.push_back(i);
+          }
+        }
+      }
+
+      const auto begin = out.begin() + static_cast<std::ptrdiff_t>(offset);
+      std::sort(begin, out.end());
+      out.erase(std::unique(begin, out.end()), out.end());
+    }
+
+  private:
+    friend class mapped_catalog;
+
+    package(const detail::catalog_package& p, const detail::catalog_entry* entries, std::string_view pool) noexcept
+      : package_{&p}, entries_{entries + p.first}, pool_{pool} {}
+
+    const detail::catalog_package* package_;
+    const detail::catalog_entry* entries_;
+    std::string_view pool_;
+
+    template <typename I1, typename I2, typename I3>
+    std::pair<std::size_t, std::size_t> rank_interval(const detail::range<I1, I2, I3>& r) const {
+      const auto [first, last] = detail::equal_range(entries_, entries_ + size(), r, detail::entry_order{ pool_ });
+      return { static_cast<std::size_t>(first - entries_), static_cast<std::size_t>(last - entries_) };
+    }
+
+    template <typename I1, typename I2, typename I3>
+    bool passes_gate(const detail::range<I1, I2, I3>& r, const detail::catalog_entry& entry) const noexcept {
+      if (entry.prerelease_length == 0) {
+        return true;
+      }
+
+      return std::any_of(r.get_comparators().begin(), r.get_comparators().end(), [&](const auto& comparator) {
+        const auto& v = comparator.get_version();
+        return !v.prerelease_tag().empty() && static_cast<std::uint64_t>(v.major()) == (entry.major_minor >> 32) &&
+          static_cast<std::uint64_t>(v.minor()) == (entry.major_minor & 0xFFFFFFFF) && static_cast<std::uint64_t>(v.patch()) == entry.patch;
+      });
+    }
+  };
+
+  mapped_catalog() = default;
+
+  mapped_catalog(const mapped_catalog&) = delete;
+  mapped_catalog& operator=(const mapped_catalog&) = delete;
+
+  mapped_catalog(mapped_catalog&& other) noexcept { swap(other); }
+
+  mapped_catalog& operator=(mapped_catalog&& other) noexcept {
+    mapped_catalog{ std::move(other) }.swap(*this);
+    return *this;
+  }
+
+  ~mapped_catalog() { close(); }
+
+  // Maps the file, or reads it where memory mapping is not available.
+  [[nodiscard]] std::errc open(const char* path) {
+    close();
+#if defined(SEMVER_IO_POSIX)
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return static_cast<std::errc>(errno);
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+      const int error = errno;
+      ::close(fd);
+      return error != 0 ? static_cast<std::errc>(error) : std::errc::invalid_argument;
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      return static_cast<std::errc>(error);
+    }
+
+    mapping_ = data;
+    mapping_size_ = size;
+    if (const auto error_code = attach(data, size); error_code != std::errc{}) {
+      close();
+      return error_code;
+    }
+    return std::errc{};
+#else
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+      return std::errc::no_such_file_or_directory;
+    }
+
+    std::vector<char> bytes;
+    char chunk[65536];
+    for (std::size_t n = 0; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+      bytes.insert(bytes.end(), chunk, chunk + n);
+    }
+    const bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    if (failed) {
+      return std::errc::io_error;
+    }
+
+    // uint64_t storage keeps the tables aligned
+    buffer_.resize((bytes.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+    std::memcpy(buffer_.data(), bytes.data(), bytes.size());
+    if (const auto error_code = attach(buffer_.data(), bytes.size()); error_code != std::errc{}) {
+      close();
+      return error_code;
+    }
+    return std::errc{};
+#endif
+  }
+
+  // Views a catalog already in memory, aligned to 8 bytes; it must outlive the mapped_catalog.
+  [[nodiscard]] std::errc attach(const void* data, std::size_t size) noexcept {
+    const auto* bytes = static_cast<const char*>(data);
+    if (reinterpret_cast<std::uintptr_t>(bytes) % alignof(std::uint64_t) != 0 || size < sizeof(detail::catalog_header)) {
+      return std::errc::invalid_argument;
+    }
+
+    const auto* header = reinterpret_cast<const detail::catalog_header*>(bytes);
+    if (std::memcmp(header->magic, detail::catalog_magic, sizeof(header->magic)) != 0 ||
+        header->byte_order != detail::catalog_byte_order || header->format != detail::catalog_format) {
+      return std::errc::invalid_argument;
+    }
+
+    const auto fits = [size](std::uint64_t offset, std::uint64_t count, std::uint64_t element) {
+      return offset % alignof(std::uint64_t) == 0 && offset <= size && count <= (size - offset) / element;
+    };
+    if (!fits(header->packages_offset, header->package_count, sizeof(detail::catalog_package)) ||
+        !fits(header->entries_offset, header->entry_count, sizeof(detail::catalog_entry)) ||
+        !fits(header->pool_offset, header->pool_size, 1)) {
+      return std::errc::invalid_argument;
+    }
+
+    const auto* packages = reinterpret_cast<const detail::catalog_package*>(bytes + header->packages_offset);
+    const std::string_view pool{ bytes + header->pool_offset, static_cast<std::size_t>(header->pool_size) };
+    for (std::uint64_t i = 0; i < header->package_count; ++i) {
+      const auto& p = packages[i];
+      if (p.first > header->entry_count || p.count > header->entry_count - p.first ||
+          p.name_offset > pool.size() || p.name_length > pool.size() - p.name_offset) {
+        return std::errc::invalid_argument;
+      }
+    }
+
+    packages_ = packages;
+    package_count_ = static_cast<std::size_t>(header->package_count);
+    entries_ = reinterpret_cast<const detail::catalog_entry*>(bytes + header->entries_offset);
+    pool_ = pool;
+    return std::errc{};
+  }
+
+  void close() noexcept {
+#if defined(SEMVER_IO_POSIX)
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    buffer_.clear();
+    packages_ = nullptr;
+    package_count_ = 0;
+    entries_ = nullptr;
+    pool_ = {};
+  }
+
+  std::size_t size() const noexcept { return package_count_; }
+
+  bool empty() const noexcept { return package_count_ == 0; }
+
+  package operator[](std::size_t index) const noexcept { return { packages_[index], entries_, pool_ }; }
+
+  // Index of the package by name, or npos.
+  std::size_t find(std::string_view name) const noexcept {
+    const auto* last = packages_ + package_count_;
+    const auto* it = std::partition_point(packages_, last, [&](const detail::catalog_package& p) {
+      return detail::pool_slice(pool_, p.name_offset, p.name_length) < name;
+    });
+    return it != last && detail::pool_slice(pool_, it->name_offset, it->name_length) == name ? static_cast<std::size_t>(it - packages_) : npos;
+  }
+
+  void swap(mapped_catalog& other) noexcept {
+    std::swap(mapping_, other.mapping_);
+    std::swap(mapping_size_, other.mapping_size_);
+    buffer_.swap(other.buffer_);
+    std::swap(packages_, other.packages_);
+    std::swap(package_count_, other.package_count_);
+    std::swap(entries_, other.entries_);
+    std::swap(pool_, other.pool_);
+  }
+
+private:
+  void* mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  std::vector<std::uint64_t> buffer_;
+
+  const detail::catalog_package* packages_ = nullptr;
+  std::size_t package_count_ = 0;
+  const detail::catalog_entry* entries_ = nullptr;
+  std::string_view pool_;
+};
+
+// Collects versions of many packages and writes them in the mapped_catalog format.
+class catalog_writer {
+public:
+  // False if a number does not fit in 32 bits.
+  template <typename I1, typename I2, typename I3>
+  bool add(std::string_view package, const version<I1, I2, I3>& v) {
+    constexpr std::uint64_t max = std::numeric_limits<std::uint32_t>::max();
+    const auto major = static_cast<std::uint64_t>(v.major());
+    const auto minor = static_cast<std::uint64_t>(v.minor());
+    const auto patch = static_cast<std::uint64_t>(v.patch());
+    if (major > max || minor > max || patch > max) {
+      return false;
+    }
+
+    records_.push_back({ std::string{package}, (major << 32) | minor, static_cast<std::uint32_t>(patch), v.prerelease_tag(), v.build_metadata() });
+    return true;
+  }
+
+  std::size_t size() const noexcept { return records_.size(); }
+
+  // The string pool is addressed with 32-bit offsets, a larger one is value_too_large.
+  [[nodiscard]] std::errc write(std::vector<char>& out) const {
+    std::vector<const record*> sorted;
+    sorted.reserve(records_.size());
+    for (const auto& r : records_) {
+      sorted.push_back(&r);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const record* lhs, const record* rhs) {
+      if (lhs->package != rhs->package) {
+        return lhs->package < rhs->package;
+      }
+      if (lhs->major_minor != rhs->major_minor) {
+        return lhs->major_minor < rhs->major_minor;
+      }
+      if (lhs->patch != rhs->patch) {
+        return lhs->patch < rhs->patch;
+      }
+      return detail::compare_prerelease_tag(lhs->prerelease_tag, rhs->prerelease_tag) < 0;
+    });
+
+    std::string pool;
+    // keys view the records, which outlive the table
+    std::unordered_map<std::string_view, std::uint32_t> interned;
+    const auto intern = [&](std::string_view text, std::uint32_t& offset) {
+      if (text.empty()) {
+        offset = 0;
+        return true;
+      }
+      if (const auto it = interned.find(text); it != interned.end()) {
+        offset = it->second;
+        return true;
+      }
+      if (pool.size() + text.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+      }
+      offset = static_cast<std::uint32_t>(pool.size());
+      pool.append(text.data(), text.size());
+      interned.emplace(text, offset);
+      return true;
+    };
+
+    std::vector<detail::catalog_package> packages;
+    std::vector<detail::catalog_entry> entries;
+    entries.reserve(sorted.size());
+    for (const record* r : sorted) {
+      if (packages.empty() || package_name(packages.back(), pool) != r->package) {
+        std::uint32_t name_offset = 0;
+        if (!intern(r->package, name_offset)) {
+          return std::errc::value_too_large;
+        }
+        packages.push_back({ name_offset, r->package.size(), entries.size(), 0 });
+      }
+      ++packages.back().count;
+
+      detail::catalog_entry entry{};
+      entry.major_minor = r->major_minor;
+      entry.patch = r->patch;
+      entry.prerelease_length = static_cast<std::uint32_t>(r->prerelease_tag.size());
+      entry.build_length = static_cast<std::uint32_t>(r->build_metadata.size());
+      if (!intern(r->prerelease_tag, entry.prerelease_offset) || !intern(r->build_metadata, entry.build_offset)) {
+        return std::errc::value_too_large;
+      }
+      entries.push_back(entry);
+    }
+
+    detail::catalog_header header{};
+    std::memcpy(header.magic, detail::catalog_magic, sizeof(header.magic));
+    header.byte_order = detail::catalog_byte_order;
+    header.format = detail::catalog_format;
+    header.package_count = packages.size();
+    header.entry_count = entries.size();
+    header.packages_offset = sizeof(header);
+    header.entries_offset = header.packages_offset + packages.size() * sizeof(detail::catalog_package);
+    header.pool_offset = header.entries_offset + entries.size() * sizeof(detail::catalog_entry);
+    header.pool_size = pool.size();
+
+    out.resize(static_cast<std::size_t>(header.pool_offset + header.pool_size));
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + header.packages_offset, packages.data(), packages.size() * sizeof(detail::catalog_package));
+    std::memcpy(out.data() + header.entries_offset, entries.data(), entries.size() * sizeof(detail::catalog_entry));
+    std::memcpy(out.data() + header.pool_offset, pool.data(), pool.size());
+    return std::errc{};
+  }
+
+  [[nodiscard]] std::errc write(const char* path) const {
+    std::vector<char> bytes;
+    if (const auto error = write(bytes); error != std::errc{}) {
+      return error;
+    }
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+      return std::errc::permission_denied;
+    }
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    const bool closed = std::fclose(file) == 0;
+    return written && closed ? std::errc{} : std::errc::io_error;
+  }
+
+private:
+  struct record {
+    std::string package;
+    std::uint64_t major_minor;
+    std::uint32_t patch;
+    std::string prerelease_tag;
+    std::string build_metadata;
+  };
+
+  std::vector<record> records_;
+
+  static std::string_view package_name(const detail::catalog_package& p, const std::string& pool) noexcept {
+    return detail::pool_slice(pool, p.name_offset, p.name_length);
+  }
+};
+
+// Where and why a stream_reader stopped; `ec == std::errc{}` at the end of the input.
+struct stream_error {
+  std::errc ec = std::errc{};
+  std::size_t line = 0;   // 1-based
+  std::size_t column = 0; // 1-based, 0 for read errors
+};
+
+// Reads newline-delimited versions (or anything else with a `semver::parse` overload) in large blocks.
+// Lines are parsed where they lie in the block, so a parsed static_version only lives until the next read.
+// Blank lines are skipped and a trailing '\r' is dropped.
+class stream_reader {
+public:
+  static constexpr std::size_t default_block_size = 1 << 16;
+
+  explicit stream_reader(std::istream& in, std::size_t block_size = default_block_size) : stream_{&in}, buffer_(std::max<std::size_t>(block_size, 1)) {}
+
+#if defined(SEMVER_IO_POSIX)
+  // Does not take ownership of the descriptor.
+  explicit stream_reader(int fd, std::size_t block_size = default_block_size) : fd_{fd}, buffer_(std::max<std::size_t>(block_size, 1)) {}
+#endif
+
+  // False at the end of the input or on an error, see error(). After an invalid line reading may go on.
+  template <typename T>
+  bool read(T& out) {
+    std::string_view text;
+    while (next_line(text)) {
+      if (text.empty()) {
+        continue;
+      }
+
+      // the whole line must be the value, parse of a range set may stop before trailing text
+      const auto result = parse(text, out);
+      if (result && result.ptr == text.data() + text.size()) {
+        return true;
+      }
+
+      error_ = { result ? std::errc::invalid_argument : result.ec, line_, static_cast<std::size_t>(result.ptr - text.data()) + 1 };
+      return false;
+    }
+    return false;
+  }
+
+  const stream_error& error() const noexcept { return error_; }
+
+  // Line of the value last read.
+  std::size_t line() const noexcept { return line_; }
+
+private:
+  std::istream* stream_ = nullptr;
+  int fd_ = -1;
+  std::vector<char> buffer_;
+  std::size_t first_ = 0;
+  std::size_t last_ = 0;
+  std::size_t line_ = 0;
+  bool eof_ = false;
+  stream_error error_;
+
+  bool next_line(std::string_view& out) {
+    error_ = {};
+    std::size_t scanned = first_;
+    while (true) {
+      const char* begin = buffer_.data() + first_;
+      if (const auto* newline = static_cast<const char*>(std::memchr(buffer_.data() + scanned, '\n', last_ - scanned)); newline != nullptr) {
+        out = trim(std::string_view{ begin, static_cast<std::size_t>(newline - begin) });
+        first_ = static_cast<std::size_t>(newline - buffer_.data()) + 1;
+        ++line_;
+        return true;
+      }
+
+      if (eof_) {
+        if (first_ == last_) {
+          error_.line = line_;
+          return false;
+        }
+        out = trim(std::string_view{ begin, last_ - first_ });
+        first_ = last_;
+        ++line_;
+        return true;
+      }
+
+      // keep the partial line, compacted to the front, and read the rest after it
+      scanned = last_ - first_;
+      std::memmove(buffer_.data(), begin, scanned);
+      first_ = 0;
+      last_ = scanned;
+      if (last_ * 2 > buffer_.size()) {
+        buffer_.resize(buffer_.size() * 2);
+      }
+      if (!fill()) {
+        error_ = { std::errc::io_error, line_ + 1, 0 };
+        return false;
+      }
+    }
+  }
+
+  bool fill() {
+    char* data = buffer_.data() + last_;
+    const std::size_t capacity = buffer_.size() - last_;
+#if defined(SEMVER_IO_POSIX)
+    if (stream_ == nullptr) {
+      ::ssize_t n = 0;
+      do {
+        n = ::read(fd_, data, capacity);
+      } while (n < 0 && errno == EINTR);
+
+      if (n < 0) {
+        return false;
+      }
+      eof_ = n == 0;
+      last_ += static_cast<std::size_t>(n);
+      return true;
+    }
+#endif
+    stream_->read(data, static_cast<std::streamsize>(capacity));
+    if (stream_->bad()) {
+      return false;
+    }
+    const auto n = static_cast<std::size_t>(stream_->gcount());
+    eof_ = n == 0;
+    last_ += n;
+    return true;
+  }
+
+  static std::string_view trim(std::string_view line) noexcept {
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    return line;
+  }
+};
+
+} // namespace semver
+
+#endif // NEARGYE_SEMANTIC_VERSIONING_IO_HPP
@@ -0,0 +1,995 @@
+//          _____                            _   _
+//         / ____|                          | | (_)
+//        | (___   ___ _ __ ___   __ _ _ __ | |_ _  ___
+//         \___ \ / _ \ '_ ` _ \ / _` | '_ \| __| |/ __|
+//         ____) |  __/ | | | | | (_| | | | | |_| | (__
+//        |_____/ \___|_| |_| |_|\__,_|_| |_|\__|_|\___|
+// __      __           _             _                _____
+// \ \    / /          (_)           (_)              / ____|_     _
+//  \ \  / /__ _ __ ___ _  ___  _ __  _ _ __   __ _  | |   _| |_ _| |_
+//   \ \/ / _ \ '__/ __| |/ _ \| '_ \| | '_ \ / _` | | |  |_   _|_   _|
+//    \  /  __/ |  \__ \ | (_) | | | | | | | | (_| | | |____|_|   |_|
+//     \/ \___|_|  |___/_|\___/|_| |_|_|_| |_|\__, |  \_____|
+// https://github.com/Neargye/semver           __/ |
+// version 1.0.0                              |___/
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018 - 2025 Daniil Goncharov <neargye@gmail.com>.
+// Copyright (c) 2020 - 2025 Alexander Gorbunov <naratzul@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+#ifndef NEARGYE_SEMANTIC_VERSIONING_RESOLVER_HPP
+#define NEARGYE_SEMANTIC_VERSIONING_RESOLVER_HPP
+
+#include "semver.hpp"
+#include "semver_concurrent.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace semver {
+
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+struct dependency {
+  std::string package;
+  range_set<I1, I2, I3> range;
+};
+
+// A registry answers two questions for the resolver, any type with the same two members works:
+//
+//   void versions(std::string_view package, std::vector<version>& out) const;
+//   bool dependencies(std::string_view package, const version& v, std::vector<dependency>& out) const;
+//
+// memory_registry keeps everything in a map, for tests, benchmarks and offline snapshots.
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+class memory_registry {
+public:
+  using version_type = version<I1, I2, I3>;
+  using dependency_type = dependency<I1, I2, I3>;
+
+  // Replaces the dependencies of a version that is already there.
+  void add(std::string_view package, const version_type& v, std::vector<dependency_type> dependencies = {}) {
+    auto it = packages_.find(package);
+    if (it == packages_.end()) {
+      it = packages_.emplace(std::string{ package }, std::vector<release>{}).first;
+    }
+
+    auto& releases = it->second;
+    const auto pos = std::find_if(releases.begin(), releases.end(), [&](const release& r) { return r.v == v; });
+    if (pos != releases.end()) {
+      pos->dependencies = std::move(dependencies);
+    } else {
+      releases.push_back({ v, std::move(dependencies) });
+    }
+  }
+
+  std::size_t size() const noexcept { return packages_.size(); }
+
+  void versions(std::string_view package, std::vector<version_type>& out) const {
+    if (const auto it = packages_.find(package); it != packages_.end()) {
+      for (const auto& r : it->second) {
+        out.push_back(r.v);
+      }
+    }
+  }
+
+  bool dependencies(std::string_view package, const version_type& v, std::vector<dependency_type>& out) const {
+    const auto it = packages_.find(package);
+    if (it == packages_.end()) {
+      return false;
+    }
+
+    for (const auto& r : it->second) {
+      if (r.v == v) {
+        out.insert(out.end(), r.dependencies.begin(), r.dependencies.end());
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  struct release {
+    version_type v;
+    std::vector<dependency_type> dependencies;
+  };
+
+  std::map<std::string, std::vector<release>, std::less<>> packages_;
+};
+
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+struct resolution {
+  // The selected version of every package the roots need, sorted by name.
+  std::vector<std::pair<std::string, version<I1, I2, I3>>> packages;
+
+  // Why the roots cannot be satisfied, one derivation per line, empty on success.
+  std::string explanation;
+
+  std::size_t decisions = 0;
+  std::size_t conflicts = 0;
+};
+
+namespace detail {
+
+  template <typename I1, typename I2, typename I3>
+  range_decomposition<I1, I2, I3> exact_set(const version<I1, I2, I3>& v, version_compare_option option) {
+    range<I1, I2, I3> r;
+    range_builder::add(r, v, range_operator::equal);
+    range_set<I1, I2, I3> result;
+    range_builder::add(result, std::move(r));
+    return decompose(result, option);
+  }
+
+  // The same answer as range_set::contains, for the set already decomposed.
+  template <typename I1, typename I2, typename I3>
+  bool contains(const range_decomposition<I1, I2, I3>& set, const version<I1, I2, I3>& v, version_compare_option option) {
+    const auto inside = [&](const interval_list<I1, I2, I3>& list) {
+      return std::any_of(list.begin(), list.end(), [&](const auto& i) { return !detail::less(v, i.lower) && (!i.bounded || detail::less(v, i.upper)); });
+    };
+
+    if (option == version_compare_option::include_prerelease || v.prerelease_tag().empty()) {
+      return inside(set.intervals);
+    }
+
+    const auto core = version_builder::core(v);
+    const auto it = std::find_if(set.prereleases.begin(), set.prereleases.end(), [&](const auto& p) { return !detail::less(p.first, core) && !detail::less(core, p.first); });
+    return it != set.prereleases.end() && inside(it->second);
+  }
+
+  // `positive` means "the package is selected, at a version of the set"; the negation,
+  // "not selected, or selected outside the set", is a term too. Sets stay decomposed into
+  // intervals while solving and only become range_set again to be explained.
+  template <typename I1, typename I2, typename I3>
+  struct resolver_term {
+    std::size_t package = 0;
+    range_decomposition<I1, I2, I3> set;
+    bool positive = true;
+
+    resolver_term negate() const { return { package, set, !positive }; }
+  };
+
+  enum class term_relation : std::uint8_t {
+    satisfied,
+    contradicted,
+    inconclusive
+  };
+
+  enum class incompatibility_cause : std::uint8_t {
+    root,
+    dependency,
+    no_versions,
+    derived
+  };
+
+  // Terms that cannot all hold at once. Learned (derived) ones come out of conflict
+  // resolution and keep the two incompatibilities they were derived from.
+  template <typename I1, typename I2, typename I3>
+  struct incompatibility {
+    std::vector<resolver_term<I1, I2, I3>> terms;
+    incompatibility_cause cause = incompatibility_cause::root;
+    std::size_t left = 0;
+    std::size_t right = 0;
+  };
+
+  template <typename I1, typename I2, typename I3>
+  struct resolver_assignment {
+    resolver_term<I1, I2, I3> term;
+    std::size_t level = 0;
+    std::size_t cause = 0; // an incompatibility, or npos for a decision
+
+    bool decision() const noexcept { return cause == static_cast<std::size_t>(-1); }
+  };
+
+  // PubGrub: unit propagation over incompatibilities, one decision at a time, and on a
+  // conflict a learned incompatibility plus a backjump to the level where it first applies.
+  // Sets are range_set, so every step works on whole intervals of versions.
+  template <typename Registry, typename I1, typename I2, typename I3>
+  class pubgrub_solver {
+  public:
+    using version_type = version<I1, I2, I3>;
+    using set_type = range_decomposition<I1, I2, I3>;
+    using term_type = resolver_term<I1, I2, I3>;
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t root = 0;
+
+    pubgrub_solver(const Registry& registry, version_compare_option option) : registry_{&registry}, option_{option} {}
+
+    bool solve(const std::vector<dependency<I1, I2, I3>>& roots, resolution<I1, I2, I3>& out) {
+      roots_ = &roots;
+      packages_.clear();
+      incompatibilities_.clear();
+      assignments_.clear();
+      undecided_.clear();
+      ids_.clear();
+      level_ = 0;
+      decisions_ = 0;
+      conflicts_ = 0;
+      failure_ = npos;
+
+      packages_.emplace_back();
+      packages_[root].fetched = true;
+      packages_[root].versions.push_back(version_builder::make(I1{0}, I2{0}, I3{0}, ""));
+      add_incompatibility({ { { root, exact_set(packages_[root].versions.front(), option_), false } }, incompatibility_cause::root, 0, 0 });
+
+      out.packages.clear();
+      out.explanation.clear();
+
+      bool solved = true;
+      for (std::size_t next = root; next != npos; next = choose_package_version()) {
+        if (!propagate(next)) {
+          solved = false;
+          break;
+        }
+      }
+
+      out.decisions = decisions_;
+      out.conflicts = conflicts_;
+      if (!solved) {
+        explain(out.explanation);
+        return false;
+      }
+
+      for (std::size_t p = root + 1; p < packages_.size(); ++p) {
+        if (packages_[p].decision != npos) {
+          out.packages.emplace_back(packages_[p].name, packages_[p].versions[packages_[p].decision]);
+        }
+      }
+      std::sort(out.packages.begin(), out.packages.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+      return true;
+    }
+
+  private:
+    struct package_state {
+      std::string name;
+      bool fetched = false;
+      std::vector<version_type> versions; // highest first
+      std::vector<std::pair<std::size_t, std::size_t>> dependencies; // incompatibilities of each version, once added
+      std::vector<std::size_t> incompatibilities;
+      std::vector<std::size_t> assignments;
+      term_type term; // the intersection of the assignments, when there are any
+      std::size_t decision = npos;
+      std::vector<char> mask; // versions inside a positive term
+      std::size_t allowed = npos; // how many, npos when stale
+      bool queued = false;
+    };
+
+    const Registry* registry_;
+    version_compare_option option_;
+    const std::vector<dependency<I1, I2, I3>>* roots_ = nullptr;
+    std::vector<package_state> packages_;
+    std::vector<incompatibility<I1, I2, I3>> incompatibilities_;
+    std::vector<resolver_assignment<I1, I2, I3>> assignments_;
+    std::vector<std::size_t> undecided_;
+    std::unordered_map<std::string, std::size_t> ids_;
+    std::size_t level_ = 0; // decisions in the partial solution
+    std::size_t decisions_ = 0;
+    std::size_t conflicts_ = 0;
+    std::size_t failure_ = npos;
+    std::vector<dependency<I1, I2, I3>> scratch_;
+
+    std::size_t id(const std::string& name) {
+      const auto [it, inserted] = ids_.emplace(name, packages_.size());
+      if (inserted) {
+        packages_.emplace_back();
+        packages_.back().name = name;
+      }
+      return it->second;
+    }
+
+    void fetch(package_state& p) {
+      if (!p.fetched) {
+        p.fetched = true;
+        registry_->versions(p.name, p.versions);
+        std::sort(p.versions.begin(), p.versions.end(), [](const auto& lhs, const auto& rhs) { return rhs < lhs; });
+        p.versions.erase(std::unique(p.versions.begin(), p.versions.end()), p.versions.end());
+      }
+    }
+
+    // Term algebra, `a` and `b` of the same package.
+    set_type intersect(const set_type& a, const set_type& b) const {
+      return combine(a, b, [](const auto& lhs, const auto& rhs) { return detail::intersect(lhs, rhs); });
+    }
+
+    set_type subtract(const set_type& a, const set_type& b) const {
+      return combine(a, b, [](const auto& lhs, const auto& rhs) { return detail::subtract(lhs, rhs); });
+    }
+
+    bool empty(const set_type& a) const { return detail::is_empty(a, option_); }
+
+    // Single intervals nested in each other, the usual case for caret and tilde ranges.
+    // False only means the full algebra has to decide.
+    static bool within(const set_type& a, const set_type& b) {
+      if (a.intervals.size() != 1 || b.intervals.size() != 1 || !a.prereleases.empty() || !b.prereleases.empty()) {
+        return false;
+      }
+      const auto& i = a.intervals.front();
+      const auto& j = b.intervals.front();
+      return !detail::less(i.lower, j.lower) && (!j.bounded || (i.bounded && !detail::less(j.upper, i.upper)));
+    }
+
+    term_type intersect(const term_type& a, const term_type& b) const {
+      if (a.positive && b.positive) {
+        return { a.package, intersect(a.set, b.set), true };
+      }
+      if (a.positive) {
+        return { a.package, subtract(a.set, b.set), true };
+      }
+      if (b.positive) {
+        return { a.package, subtract(b.set, a.set), true };
+      }
+      return { a.package, combine(a.set, b.set, [](const auto& lhs, const auto& rhs) { return detail::unite(lhs, rhs); }), false };
+    }
+
+    // Every selection allowed by `a` is allowed by `b`.
+    bool satisfies(const term_type& a, const term_type& b) const {
+      if (a.positive && b.positive && within(a.set, b.set)) {
+        return true;
+      }
+      if (a.positive) {
+        return empty(b.positive ? subtract(a.set, b.set) : intersect(a.set, b.set));
+      }
+      return !b.positive && empty(subtract(b.set, a.set));
+    }
+
+    bool disjoint(const term_type& a, const term_type& b) const {
+      if (a.positive && b.positive) {
+        return empty(intersect(a.set, b.set));
+      }
+      if (a.positive) {
+        return empty(subtract(a.set, b.set));
+      }
+      return b.positive && empty(subtract(b.set, a.set));
+    }
+
+    term_relation relation(const term_type& t) {
+      auto& p = packages_[t.package];
+      if (p.assignments.empty()) {
+        return term_relation::inconclusive;
+      }
+      if (p.decision != npos) {
+        // a single version, no set algebra needed
+        return detail::contains(t.set, p.versions[p.decision], option_) == t.positive ? term_relation::satisfied : term_relation::contradicted;
+      }
+
+      if (p.term.positive) {
+        // two published versions of the term, one inside `t` and one outside, settle it cheaply
+        refresh(p);
+        bool inside = false;
+        bool outside = false;
+        for (std::size_t i = 0; i < p.versions.size() && !(inside && outside); ++i) {
+          if (p.mask[i]) {
+            (detail::contains(t.set, p.versions[i], option_) == t.positive ? inside : outside) = true;
+          }
+        }
+        if (inside && outside) {
+          return term_relation::inconclusive;
+        }
+      }
+
+      if (satisfies(p.term, t)) {
+        return term_relation::satisfied;
+      }
+      return disjoint(p.term, t) ? term_relation::contradicted : term_relation::inconclusive;
+    }
+
+    // Satisfied, contradicted, or almost satisfied (inconclusive with exactly one term left
+    // out, `unsatisfied`). Inconclusive otherwise, with `unsatisfied == npos`.
+    term_relation relation(const incompatibility<I1, I2, I3>& incompatibility, std::size_t& unsatisfied) {
+      unsatisfied = npos;
+      for (std::size_t i = 0; i < incompatibility.terms.size(); ++i) {
+        const auto r = relation(incompatibility.terms[i]);
+        if (r == term_relation::contradicted) {
+          return r;
+        }
+        if (r == term_relation::inconclusive) {
+          if (unsatisfied != npos) {
+            unsatisfied = npos;
+            return r;
+          }
+          unsatisfied = i;
+        }
+      }
+      return unsatisfied == npos ? term_relation::satisfied : term_relation::inconclusive;
+    }
+
+    std::size_t add_incompatibility(incompatibility<I1, I2, I3> incompatibility) {
+      auto& terms = incompatibility.terms;
+      std::vector<term_type> merged;
+      for (auto& t : terms) {
+        const auto same = std::find_if(merged.begin(), merged.end(), [&](const term_type& m) { return m.package == t.package; });
+        if (same != merged.end()) {
+          *same = intersect(*same, t);
+        } else {
+          merged.push_back(std::move(t));
+        }
+      }
+      // "root is selected" always holds, it adds nothing to a learned incompatibility
+      if (incompatibility.cause == incompatibility_cause::derived && merged.size() > 1) {
+        merged.erase(std::remove_if(merged.begin(), merged.end(), [](const term_type& t) { return t.package == root && t.positive; }), merged.end());
+      }
+      terms = std::move(merged);
+
+      const std::size_t index = incompatibilities_.size();
+      for (const auto& t : terms) {
+        packages_[t.package].incompatibilities.push_back(index);
+      }
+      incompatibilities_.push_back(std::move(incompatibility));
+      return index;
+    }
+
+    void assign(term_type t, std::size_t cause) {
+      auto& p = packages_[t.package];
+      const bool decision = cause == npos;
+      if (decision) {
+        ++level_;
+        ++decisions_;
+      }
+
+      p.term = p.assignments.empty() ? t : intersect(p.term, t);
+      p.assignments.push_back(assignments_.size());
+      p.allowed = npos;
+      assignments_.push_back({ std::move(t), level_, cause });
+      enqueue(p);
+    }
+
+    // Packages that may have a positive term and no decision, for choose_package_version.
+    void enqueue(package_state& p) {
+      if (!p.queued && p.decision == npos && !p.assignments.empty() && p.term.positive) {
+        p.queued = true;
+        undecided_.push_back(static_cast<std::size_t>(&p - packages_.data()));
+      }
+    }
+
+    void backtrack(std::size_t target) {
+      while (!assignments_.empty() && assignments_.back().level > target) {
+        const auto& a = assignments_.back();
+        auto& p = packages_[a.term.package];
+        if (a.decision()) {
+          p.decision = npos;
+          --level_;
+        }
+        p.assignments.pop_back();
+        p.allowed = npos;
+        if (!p.assignments.empty()) {
+          p.term = assignments_[p.assignments.front()].term;
+          for (std::size_t i = 1; i < p.assignments.size(); ++i) {
+            p.term = intersect(p.term, assignments_[p.assignments[i]].term);
+          }
+        }
+        assignments_.pop_back();
+        enqueue(p);
+      }
+    }
+
+    // The earliest assignment after which the solution satisfies `t`.
+    std::size_t satisfier(const term_type& t) const {
+      const auto& p = packages_[t.package];
+      term_type accumulated;
+      for (std::size_t i = 0; i < p.assignments.size(); ++i) {
+        const auto& a = assignments_[p.assignments[i]];
+        accumulated = i == 0 ? a.term : intersect(accumulated, a.term);
+        if (satisfies(accumulated, t)) {
+          return p.assignments[i];
+        }
+      }
+      return npos;
+    }
+
+    bool propagate(std::size_t package) {
+      std::vector<std::size_t> changed{ package };
+      while (!changed.empty()) {
+        const std::size_t p = changed.back();
+        changed.pop_back();
+
+        // newest first: learned incompatibilities tend to fail or derive sooner
+        for (std::size_t k = packages_[p].incompatibilities.size(); k-- > 0;) {
+          std::size_t i = packages_[p].incompatibilities[k];
+          std::size_t unsatisfied = npos;
+          auto r = relation(incompatibilities_[i], unsatisfied);
+
+          if (r == term_relation::satisfied) {
+            i = resolve_conflict(i);
+            if (i == npos) {
+              return false;
+            }
+            r = relation(incompatibilities_[i], unsatisfied);
+            const auto t = incompatibilities_[i].terms[unsatisfied].negate();
+            assign(t, i);
+            changed.clear();
+            changed.push_back(t.package);
+            break;
+          }
+
+          if (r == term_relation::inconclusive && unsatisfied != npos) {
+            const auto t = incompatibilities_[i].terms[unsatisfied].negate();
+            assign(t, i);
+            if (std::find(changed.begin(), changed.end(), t.package) == changed.end()) {
+              changed.push_back(t.package);
+            }
+          }
+        }
+      }
+      return true;
+    }
+
+    bool failed(const incompatibility<I1, I2, I3>& incompatibility) const {
+      const auto& terms = incompatibility.terms;
+      return terms.empty() || (terms.size() == 1 && terms.front().package == root && terms.front().positive);
+    }
+
+    // Learns from a satisfied incompatibility until one is found that, after backjumping,
+    // is almost satisfied. npos when the roots are what conflicts.
+    std::size_t resolve_conflict(std::size_t i) {
+      ++conflicts_;
+      while (!failed(incompatibilities_[i])) {
+        const auto& terms = incompatibilities_[i].terms;
+        std::size_t most_recent = npos;
+        std::size_t most_recent_term = npos;
+        std::size_t previous_level = 1;
+
+        for (std::size_t k = 0; k < terms.size(); ++k) {
+          const std::size_t s = satisfier(terms[k]);
+          if (most_recent == npos || most_recent < s) {
+            if (most_recent != npos) {
+              previous_level = std::max(previous_level, assignments_[most_recent].level);
+            }
+            most_recent = s;
+            most_recent_term = k;
+          } else {
+            previous_level = std::max(previous_level, assignments_[s].level);
+          }
+        }
+
+        // the most recent satisfier may leave part of its term to an earlier assignment
+        const auto& s = assignments_[most_recent];
+        const auto& t = terms[most_recent_term];
+        const auto rest = intersect(s.term, t.negate());
+        const bool partial = !(rest.positive && empty(rest.set));
+        if (partial) {
+          if (const std::size_t earlier = satisfier(rest.negate()); earlier != npos) {
+            previous_level = std::max(previous_level, assignments_[earlier].level);
+          }
+        }
+
+        if (s.decision() || previous_level < s.level) {
+          backtrack(previous_level);
+          return i;
+        }
+
+        incompatibility<I1, I2, I3> prior{ {}, incompatibility_cause::derived, i, s.cause };
+        for (std::size_t k = 0; k < terms.size(); ++k) {
+          if (k != most_recent_term) {
+            prior.terms.push_back(terms[k]);
+          }
+        }
+        for (const auto& c : incompatibilities_[s.cause].terms) {
+          if (c.package != s.term.package) {
+            prior.terms.push_back(c);
+          }
+        }
+        if (partial) {
+          prior.terms.push_back(rest.negate());
+        }
+        i = add_incompatibility(std::move(prior));
+      }
+      failure_ = i;
+      return npos;
+    }
+
+    // The undecided package with the fewest versions left, decided at its highest one.
+    // npos when every package with a positive term is decided.
+    std::size_t choose_package_version() {
+      std::size_t best = npos;
+      std::size_t kept = 0;
+      for (const std::size_t p : undecided_) {
+        auto& state = packages_[p];
+        if (state.decision != npos || state.assignments.empty() || !state.term.positive) {
+          state.queued = false;
+          continue;
+        }
+        undecided_[kept++] = p;
+        if (best != npos && packages_[best].allowed == 0) {
+          continue;
+        }
+
+        refresh(state);
+        // ties go to the package seen first, closer to the roots
+        if (best == npos || state.allowed < packages_[best].allowed || (state.allowed == packages_[best].allowed && p < best)) {
+          best = p;
+        }
+      }
+      undecided_.resize(kept);
+      if (best == npos) {
+        return npos;
+      }
+
+      auto& state = packages_[best];
+      const std::size_t decision = static_cast<std::size_t>(std::find(state.mask.begin(), state.mask.end(), char{ 1 }) - state.mask.begin());
+      if (decision == state.versions.size()) {
+        add_incompatibility({ { state.term }, incompatibility_cause::no_versions, 0, 0 });
+        return best;
+      }
+
+      const auto it = state.versions.begin() + static_cast<std::ptrdiff_t>(decision);
+      const set_type selected = exact_set(*it, option_);
+      if (state.dependencies.empty()) {
+        state.dependencies.assign(state.versions.size(), { npos, 0 });
+      }
+
+      // dependencies become incompatibilities once per version, a backjump may come back to it
+      auto [first, last] = state.dependencies[decision];
+      if (first == npos) {
+        scratch_.clear();
+        if (best == root) {
+          scratch_ = *roots_;
+        } else {
+          registry_->dependencies(state.name, *it, scratch_);
+        }
+
+        first = incompatibilities_.size();
+        for (auto& d : scratch_) {
+          const std::size_t q = id(d.package);
+          add_incompatibility({ { { best, selected, true }, { q, decompose(d.range, option_), false } }, incompatibility_cause::dependency, 0, 0 });
+        }
+        last = incompatibilities_.size();
+        packages_[best].dependencies[decision] = { first, last };
+      }
+
+      // a dependency that is already ruled out makes this version a conflict: leave it to propagation
+      bool conflict = false;
+      for (std::size_t i = first; i < last && !conflict; ++i) {
+        // no version at all in the dependency's range is known without deciding anything, and
+        // learning it here keeps it from surfacing only after a deep backjump
+        const auto& d = incompatibilities_[i].terms.back();
+        if (!d.positive && d.package != best && packages_[d.package].assignments.empty() && !any_version(d)) {
+          term_type excluded = d;
+          const std::size_t none = add_incompatibility({ { excluded.negate() }, incompatibility_cause::no_versions, 0, 0 });
+          assign(std::move(excluded), none);
+        }
+
+        conflict = std::all_of(incompatibilities_[i].terms.begin(), incompatibilities_[i].terms.end(), [&](const term_type& t) {
+          return t.package == best || relation(t) == term_relation::satisfied;
+        });
+      }
+
+      if (!conflict) {
+        packages_[best].decision = decision;
+        assign({ best, selected, true }, npos);
+      }
+      return best;
+    }
+
+    void refresh(package_state& p) {
+      if (p.allowed == npos) {
+        fetch(p);
+        p.mask.resize(p.versions.size());
+        for (std::size_t i = 0; i < p.versions.size(); ++i) {
+          p.mask[i] = detail::contains(p.term.set, p.versions[i], option_);
+        }
+        p.allowed = static_cast<std::size_t>(std::count(p.mask.begin(), p.mask.end(), char{ 1 }));
+      }
+    }
+
+    bool any_version(const term_type& t) {
+      auto& p = packages_[t.package];
+      fetch(p);
+      return std::any_of(p.versions.begin(), p.versions.end(), [&](const version_type& v) { return detail::contains(t.set, v, option_); });
+    }
+
+    std::string describe(const term_type& t) const {
+      if (t.package == root) {
+        return "root";
+      }
+      return packages_[t.package].name + " " + compose(t.set, option_).to_string();
+    }
+
+    std::string describe(const incompatibility<I1, I2, I3>& incompatibility) const {
+      const auto& terms = incompatibility.terms;
+      if (failed(incompatibility)) {
+        return "version solving failed";
+      }
+      if (incompatibility.cause == incompatibility_cause::no_versions) {
+        return "no versions of " + packages_[terms.front().package].name + " match " + compose(terms.front().set, option_).to_string();
+      }
+      if (incompatibility.cause == incompatibility_cause::dependency && terms.size() == 2) {
+        return describe(terms[0]) + " depends on " + describe(terms[1]);
+      }
+
+      std::string positive;
+      std::string negative;
+      for (const auto& t : terms) {
+        auto& text = t.positive ? positive : negative;
+        text += text.empty() ? "" : t.positive ? " and " : " or ";
+        text += describe(t);
+      }
+      if (negative.empty()) {
+        return positive + " is forbidden";
+      }
+      if (positive.empty()) {
+        return negative + " is required";
+      }
+      return positive + " requires " + negative;
+    }
+
+    // One numbered line per learned incompatibility, causes before what they derive.
+    void explain(std::string& out) const {
+      std::vector<std::size_t> lines(incompatibilities_.size(), 0);
+      std::size_t count = 0;
+      std::vector<std::pair<std::size_t, bool>> stack{ { failure_, false } };
+
+      const auto reason = [&](std::size_t i) {
+        return incompatibilities_[i].cause == incompatibility_cause::derived ? "(" + std::to_string(lines[i]) + ")" : describe(incompatibilities_[i]);
+      };
+
+      while (!stack.empty()) {
+        const auto [i, expanded] = stack.back();
+        stack.pop_back();
+        const auto& c = incompatibilities_[i];
+        if (c.cause != incompatibility_cause::derived || lines[i] != 0) {
+          continue;
+        }
+        if (!expanded) {
+          stack.push_back({ i, true });
+          stack.push_back({ c.right, false });
+          stack.push_back({ c.left, false });
+          continue;
+        }
+
+        lines[i] = ++count;
+        out += "(" + std::to_string(count) + ") Because " + reason(c.left) + " and " + reason(c.right) + ", " + describe(c) + ".\n";
+      }
+
+      if (count == 0) {
+        out = describe(incompatibilities_[failure_]) + ".\n";
+      }
+    }
+  };
+
+} // namespace semver::detail
+
+// A version for every package the roots reach, each inside the ranges of everything that
+// depends on it, preferring higher versions. On a conflict `out.explanation` says why.
+template <typename Registry, typename I1, typename I2, typename I3>
+bool resolve(const Registry& registry, const std::vector<dependency<I1, I2, I3>>& roots, resolution<I1, I2, I3>& out,
+             version_compare_option option = version_compare_option::exclude_prerelease) {
+  detail::pubgrub_solver<Registry, I1, I2, I3> solver{ registry, option };
+  return solver.solve(roots, out);
+}
+
+// The least version of a module that something needs, as in Go's minimal version selection.
+template <typename I1 = int, typename I2 = int, typename I3 = int>
+struct requirement {
+  std::string module;
+  version<I1, I2, I3> minimum;
+};
+
+namespace detail {
+
+  // Precedence packed in two words, major.minor then patch with a release bit, so most
+  // comparisons are two integer compares. Equal keys of two prereleases still need the tags.
+  struct precedence_key {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+  };
+
+  template <typename I1, typename I2, typename I3>
+  inline constexpr bool packs_precedence_key = sizeof(I1) <= 4 && sizeof(I2) <= 4 && sizeof(I3) <= 4;
+
+  template <typename I1, typename I2, typename I3>
+  precedence_key make_precedence_key(const version<I1, I2, I3>& v) noexcept {
+    if constexpr (packs_precedence_key<I1, I2, I3>) {
+      return { static_cast<std::uint64_t>(v.major()) << 32 | static_cast<std::uint64_t>(v.minor()),
+               static_cast<std::uint64_t>(v.patch()) << 1 | static_cast<std::uint64_t>(v.prerelease_tag().empty()) };
+    } else {
+      return {};
+    }
+  }
+
+  template <typename I1, typename I2, typename I3>
+  int compare(const version<I1, I2, I3>& lhs, precedence_key lhs_key, const version<I1, I2, I3>& rhs, precedence_key rhs_key) noexcept {
+    if constexpr (packs_precedence_key<I1, I2, I3>) {
+      if (lhs_key.high != rhs_key.high) {
+        return lhs_key.high < rhs_key.high ? -1 : 1;
+      }
+      if (lhs_key.low != rhs_key.low) {
+        return lhs_key.low < rhs_key.low ? -1 : 1;
+      }
+      if (lhs_key.low & 1) {
+        return 0;
+      }
+    }
+    return compare_parsed(lhs, rhs, version_compare_option::include_prerelease);
+  }
+
+  template <typename I1, typename I2, typename I3, typename Provider>
+  class mvs_walker {
+  public:
+    mvs_walker(Provider& provider, unsigned threads) : provider_{&provider}, threads_{threads} {}
+
+    std::vector<requirement<I1, I2, I3>> walk(const std::vector<requirement<I1, I2, I3>>& roots) {
+      for (const auto& r : roots) {
+        visit(r.module, r.minimum);
+      }
+
+      // level by level: the requirements of a whole frontier are fetched in parallel, then
+      // merged on this thread, so the result does not depend on the number of threads
+      std::vector<std::vector<requirement<I1, I2, I3>>> found;
+      while (!frontier_.empty()) {
+        found.assign(frontier_.size(), {});
+        expand(found);
+
+        const std::vector<std::size_t> current = std::move(frontier_);
+        frontier_.clear();
+        for (std::size_t i = 0; i < current.size(); ++i) {
+          for (const auto& r : found[i]) {
+            visit(r.module, r.minimum);
+          }
+        }
+      }
+
+      std::vector<requirement<I1, I2, I3>> result;
+      result.reserve(modules_.size());
+      for (const auto& m : modules_) {
+        result.push_back({ m.name, nodes_[m.best].v });
+      }
+      std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) { return lhs.module < rhs.module; });
+      return result;
+    }
+
+  private:
+    // Frontiers smaller than this are cheaper to expand on this thread.
+    static constexpr std::size_t parallel_threshold = 256;
+
+    struct node {
+      std::size_t module = 0;
+      version<I1, I2, I3> v;
+      precedence_key key;
+    };
+
+    struct module_state {
+      std::string name;
+      std::size_t best = 0;
+    };
+
+    Provider* provider_;
+    unsigned threads_;
+    std::vector<node> nodes_;
+    std::vector<module_state> modules_;
+    std::unordered_map<std::string, std::size_t> ids_;
+    // Every node in an open-addressing table keyed by module and version, one probe per visit.
+    struct seen_slot {
+      std::size_t hash = 0;
+      std::size_t node = npos;
+    };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    std::vector<seen_slot> seen_;
+    std::size_t seen_count_ = 0;
+    std::vector<std::size_t> frontier_;
+
+    static std::size_t hash(std::size_t module, const version<I1, I2, I3>& v) noexcept {
+      std::uint64_t h = (static_cast<std::uint64_t>(v.hash()) ^ module) * 0x9e3779b97f4a7c15ULL;
+      return static_cast<std::size_t>(h ^ h >> 32);
+    }
+
+    // The slot of module@v, or the empty slot where it would go.
+    seen_slot& find_slot(std::size_t h, std::size_t module, const version<I1, I2, I3>& v, const precedence_key& key) noexcept {
+      const std::size_t mask = seen_.size() - 1;
+      for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+        auto& slot = seen_[i];
+        if (slot.node == npos) {
+          return slot;
+        }
+        if (slot.hash == h) {
+          const auto& n = nodes_[slot.node];
+          if (n.module == module && compare(n.v, n.key, v, key) == 0) {
+            return slot;
+          }
+        }
+      }
+    }
+
+    void grow_seen() {
+      std::vector<seen_slot> slots(seen_.empty() ? 64 : seen_.size() * 2);
+      seen_.swap(slots);
+      const std::size_t mask = seen_.size() - 1;
+      for (const auto& slot : slots) {
+        if (slot.node != npos) {
+          std::size_t i = slot.hash & mask;
+          while (seen_[i].node != npos) {
+            i = (i + 1) & mask;
+          }
+          seen_[i] = slot;
+        }
+      }
+    }
+
+    void visit(const std::string& module, const version<I1, I2, I3>& v) {
+      auto it = ids_.find(module);
+      const bool inserted = it == ids_.end();
+      if (inserted) {
+        it = ids_.emplace(module, modules_.size()).first;
+        modules_.push_back({ module, nodes_.size() });
+      }
+
+      if ((seen_count_ + 1) * 2 > seen_.size()) {
+        grow_seen();
+      }
+      const precedence_key key = make_precedence_key(v);
+      const std::size_t h = hash(it->second, v);
+      auto& slot = find_slot(h, it->second, v, key);
+      if (slot.node != npos) {
+        return;
+      }
+      slot = { h, nodes_.size() };
+      ++seen_count_;
+
+      auto& m = modules_[it->second];
+      if (!inserted && compare(nodes_[m.best].v, nodes_[m.best].key, v, key) < 0) {
+        m.best = nodes_.size();
+      }
+      frontier_.push_back(nodes_.size());
+      nodes_.push_back({ it->second, v, key });
+    }
+
+    void expand(std::vector<std::vector<requirement<I1, I2, I3>>>& found) {
+      const auto fetch = [&](std::size_t i) {
+        const auto& n = nodes_[frontier_[i]];
+        (*provider_)(std::string_view{ modules_[n.module].name }, n.v, found[i]);
+      };
+
+      if (frontier_.size() < parallel_threshold || threads_ == 1) {
+        for (std::size_t i = 0; i < frontier_.size(); ++i) {
+          fetch(i);
+        }
+        return;
+      }
+
+      parallel_for(frontier_.size(), threads_, [&] { return fetch; });
+    }
+  };
+
+} // namespace semver::detail
+
+// Minimal version selection: every module@version reachable from the roots is visited once
+// and the build list keeps, per module, the highest version anything requires. The result
+// is sorted by module. `provider(module, version, out)` appends the requirements of
+// module@version to `out`; it is called from several threads at once unless `threads == 1`
+// (`threads == 0` uses every hardware thread).
+template <typename I1, typename I2, typename I3, typename Provider>
+std::vector<requirement<I1, I2, I3>> mvs_resolve(const std::vector<requirement<I1, I2, I3>>& roots, Provider&& provider, unsigned threads = 0) {
+  detail::mvs_walker<I1, I2, I3, std::remove_reference_t<Provider>> walker{ provider, threads };
+  return walker.walk(roots);
+}
+
+} // namespace semver
+
+#endif // NEARGYE_SEMANTIC_VERSIONING_RESOLVER_HPP
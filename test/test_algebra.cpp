@@ -0,0 +1,213 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+static constexpr std::array<std::string_view, 14> algebra_ranges = {{
+  {">=1.0.0 <2.0.0"},
+  {">1.2.3-alpha.3"},
+  {">=1.2.3-alpha.7 <2.0.0"},
+  {">1.2.3 <2.0.0-alpha.10"},
+  {">1.2.3 <2.0.0-alpha.1 || <=2.0.0-alpha.5"},
+  {"<=2.0.0-alpha.4"},
+  {"1.2.3"},
+  {"1.2.7 || >=1.2.9 <2.0.0"},
+  {">=3.4.5-alpha.1 || <1.0.0"},
+  {">5.0.0"},
+  {">2.0.0 <1.0.0"},
+  {"<=1.0.0-beta.2 >=1.0.0-alpha"},
+  {"<1.2.4 || >=1.3.0-rc.1 <1.3.0"},
+  {"=1.2.3-alpha.7 || >=0.0.0"}
+}};
+
+static constexpr std::array<std::string_view, 30> algebra_versions = {{
+  {"0.0.0-0"},
+  {"0.0.0"},
+  {"0.9.0"},
+  {"1.0.0-alpha"},
+  {"1.0.0-beta.2"},
+  {"1.0.0-beta.2.0"},
+  {"1.0.0"},
+  {"1.2.3-0"},
+  {"1.2.3-alpha.3"},
+  {"1.2.3-alpha.3.0"},
+  {"1.2.3-alpha.7"},
+  {"1.2.3"},
+  {"1.2.4-0"},
+  {"1.2.4"},
+  {"1.2.7"},
+  {"1.2.8"},
+  {"1.2.9"},
+  {"1.3.0-rc.1"},
+  {"1.3.0"},
+  {"1.4.6"},
+  {"2.0.0-alpha.1"},
+  {"2.0.0-alpha.4"},
+  {"2.0.0-alpha.5"},
+  {"2.0.0-alpha.10"},
+  {"2.0.0"},
+  {"2.1.0"},
+  {"3.4.5-alpha.9"},
+  {"3.4.5"},
+  {"5.0.0"},
+  {"5.0.1"}
+}};
+
+TEST_CASE("range algebra") {
+  std::vector<range_set<>> ranges;
+  for (auto str : algebra_ranges) {
+    range_set<> r;
+    REQUIRE(parse(str, r));
+    ranges.push_back(r);
+  }
+
+  std::vector<version<>> versions;
+  for (auto str : algebra_versions) {
+    version<> v;
+    REQUIRE(parse(str, v));
+    versions.push_back(v);
+  }
+
+  for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+    for (const auto& a : ranges) {
+      const auto not_a = complement(a, option);
+      for (const auto& v : versions) {
+        const bool expected = !a.contains(v, option) && (option == version_compare_option::include_prerelease || v.prerelease_tag().empty());
+        REQUIRE(not_a.contains(v, option) == expected);
+      }
+
+      for (const auto& b : ranges) {
+        const auto both = intersect(a, b, option);
+        const auto either = unite(a, b, option);
+        const auto only_a = difference(a, b, option);
+
+        for (const auto& v : versions) {
+          const bool in_a = a.contains(v, option);
+          const bool in_b = b.contains(v, option);
+          REQUIRE(both.contains(v, option) == (in_a && in_b));
+          REQUIRE(either.contains(v, option) == (in_a || in_b));
+          REQUIRE(only_a.contains(v, option) == (in_a && !in_b));
+        }
+      }
+    }
+  }
+}
+
+static version<> make_version(std::string_view str) {
+  version<> v;
+  REQUIRE(parse(str, v));
+  return v;
+}
+
+static range_set<> make_range(std::string_view str) {
+  range_set<> r;
+  REQUIRE(parse(str, r));
+  return r;
+}
+
+TEST_CASE("range algebra bounds") {
+  range_set<> a;
+  range_set<> b;
+  REQUIRE(parse(">=1.0.0 <=1.5.0", a));
+  REQUIRE(parse(">1.5.0 <2.0.0", b));
+
+  const auto r = unite(a, b);
+  REQUIRE(r.get_ranges().size() == 1);
+  REQUIRE(r.contains(make_version("1.5.0")));
+  REQUIRE(r.contains(make_version("1.9.9")));
+  REQUIRE_FALSE(r.contains(make_version("2.0.0")));
+
+  REQUIRE(intersect(a, b).get_ranges().empty());
+  REQUIRE(difference(a, a).get_ranges().empty());
+  REQUIRE(complement(complement(a)).contains(make_version("1.2.0")));
+}
+
+TEST_CASE("range algebra decomposition") {
+  // 1.2.3-rc.1 opens the gate for 1.2.3 prereleases, none of which are in the range
+  range_set<> r;
+  REQUIRE(parse(">1.2.3-rc.1 >=2.0.0", r));
+  const auto d = detail::decompose(r, version_compare_option::exclude_prerelease);
+  REQUIRE(d.prereleases.empty());
+  REQUIRE(d.intervals.size() == 1);
+}
+
+TEST_CASE("range emptiness and subset") {
+  REQUIRE(is_empty(make_range(">2.0.0 <1.0.0")));
+  REQUIRE(is_empty(make_range(">1.2.3-alpha <1.2.3-alpha.0")));
+  REQUIRE(is_empty(make_range(">1.2.3 <1.2.4-0")));
+  REQUIRE_FALSE(is_empty(make_range(">1.2.3 <=1.2.4-0")));
+  REQUIRE(is_empty(make_range(">1.2.3 <1.2.4 || >1.0.0-rc.1 <1.0.0-beta")));
+  REQUIRE_FALSE(is_empty(make_range(">1.2.3 <1.2.4 || >1.0.0-rc.1 <1.0.0-beta"), version_compare_option::include_prerelease));
+  REQUIRE_FALSE(is_empty(make_range(">=1.2.3-alpha <1.2.3")));
+
+  REQUIRE(is_subset(make_range(">=1.2.3 <1.3.0"), make_range(">=1.0.0 <2.0.0")));
+  REQUIRE_FALSE(is_subset(make_range(">=1.0.0 <2.0.0"), make_range(">=1.2.3 <1.3.0")));
+  REQUIRE_FALSE(is_subset(make_range(">=1.2.3-alpha <1.3.0"), make_range(">=1.2.0 <2.0.0")));
+  REQUIRE(is_subset(make_range(">1.2.3 <1.2.4"), make_range("1.2.3")));
+  REQUIRE_FALSE(is_subset(make_range(">1.2.3 <1.2.4"), make_range("1.2.3"), version_compare_option::include_prerelease));
+}
+
+// Ranges built from a small grid of versions, checked against every version that can
+// witness a difference: the grid, the successors of its versions and their cores.
+TEST_CASE("range emptiness and subset properties") {
+  constexpr std::array<std::string_view, 3> tags = {{{""}, {"alpha"}, {"beta"}}};
+  constexpr std::array<std::string_view, 6> operators = {{{""}, {"="}, {"<"}, {"<="}, {">"}, {">="}}};
+  constexpr std::array<std::string_view, 7> probe_tags = {{{""}, {"0"}, {"0.0"}, {"alpha"}, {"alpha.0"}, {"beta"}, {"beta.0"}}};
+
+  std::vector<version<>> probes;
+  for (int major = 0; major <= 2; ++major) {
+    for (int minor = 0; minor <= 2; ++minor) {
+      for (int patch = 0; patch <= 3; ++patch) {
+        for (auto tag : probe_tags) {
+          std::string str = std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch);
+          if (!tag.empty()) {
+            str += "-" + std::string{tag};
+          }
+          probes.push_back(make_version(str));
+        }
+      }
+    }
+  }
+
+  std::mt19937 rng{20240917};
+  const auto pick = [&](int n) { return static_cast<int>(rng() % static_cast<unsigned>(n)); };
+  const auto random_range = [&] {
+    std::string str;
+    for (int i = 0, ranges = 1 + pick(2); i < ranges; ++i) {
+      if (i > 0) {
+        str += " || ";
+      }
+      for (int j = 0, comparators = 1 + pick(3); j < comparators; ++j) {
+        if (j > 0) {
+          str += " ";
+        }
+        str += std::string{operators[pick(6)]} + std::to_string(pick(3)) + "." + std::to_string(pick(3)) + "." + std::to_string(pick(3));
+        if (auto tag = tags[pick(3)]; !tag.empty()) {
+          str += "-" + std::string{tag};
+        }
+      }
+    }
+    return make_range(str);
+  };
+
+  for (int iteration = 0; iteration < 500; ++iteration) {
+    const auto a = random_range();
+    const auto b = random_range();
+    const auto canonical = make_range(a.to_string());
+    REQUIRE(canonical.to_string() == a.to_string());
+
+    for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+      const bool a_empty = std::none_of(probes.begin(), probes.end(), [&](const auto& v) { return a.contains(v, option); });
+      const bool a_subset_b = std::all_of(probes.begin(), probes.end(), [&](const auto& v) { return !a.contains(v, option) || b.contains(v, option); });
+
+      REQUIRE(std::all_of(probes.begin(), probes.end(), [&](const auto& v) { return canonical.contains(v, option) == a.contains(v, option); }));
+      REQUIRE(is_empty(a, option) == a_empty);
+      REQUIRE(is_subset(a, b, option) == a_subset_b);
+    }
+  }
+}
@@ -0,0 +1,129 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <array>
+#include <string>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+TEST_CASE("binary serialization") {
+  SECTION("version round trip") {
+    for (auto str : valid_versions) {
+      version<> v;
+      REQUIRE(parse(str, v));
+
+      std::array<char, 128> buffer{};
+      const auto written = serialize(buffer.data(), buffer.data() + buffer.size(), v);
+      REQUIRE(written);
+      REQUIRE(static_cast<std::size_t>(written.ptr - buffer.data()) < str.size() + 5);
+
+      version<> decoded;
+      const auto read = deserialize(buffer.data(), static_cast<const char*>(written.ptr), decoded);
+      REQUIRE(read);
+      REQUIRE(read.ptr == written.ptr);
+      REQUIRE(decoded.to_string() == str);
+      REQUIRE(decoded == v);
+      REQUIRE(decoded.hash() == v.hash());
+    }
+  }
+
+  SECTION("layout") {
+    version<> v;
+    REQUIRE(parse("1.200.3-rc.1+b", v));
+    std::array<char, 32> buffer{};
+    const auto written = serialize(buffer.data(), buffer.data() + buffer.size(), v);
+    REQUIRE(written);
+    const std::string expected = { 1, '\xC8', 1, 3, 5, 4, 'r', 'c', 3, '1', 1, 'b' };
+    REQUIRE(std::string(buffer.data(), written.ptr) == expected);
+  }
+
+  SECTION("buffer too small") {
+    version<> v;
+    REQUIRE(parse("1.2.3-alpha.1", v));
+    std::array<char, 8> buffer{};
+    const auto written = serialize(buffer.data(), buffer.data() + buffer.size(), v);
+    REQUIRE(written.ec == std::errc::value_too_large);
+  }
+
+  SECTION("concatenated values") {
+    std::array<char, 64> buffer{};
+    char* current = buffer.data();
+    for (auto str : { "1.0.0", "2.0.0-beta.2", "3.0.0+build" }) {
+      version<> v;
+      REQUIRE(parse(str, v));
+      const auto written = serialize(current, buffer.data() + buffer.size(), v);
+      REQUIRE(written);
+      current = written.ptr;
+    }
+
+    const char* first = buffer.data();
+    std::string joined;
+    while (first != current) {
+      version<> v;
+      const auto read = deserialize(first, static_cast<const char*>(current), v);
+      REQUIRE(read);
+      joined += v.to_string() + ";";
+      first = read.ptr;
+    }
+    REQUIRE(joined == "1.0.0;2.0.0-beta.2;3.0.0+build;");
+  }
+
+  SECTION("invalid input") {
+    version<> v;
+    const auto decode = [&](const std::string& bytes) { return deserialize(bytes.data(), bytes.data() + bytes.size(), v); };
+
+    REQUIRE_FALSE(decode({}));
+    REQUIRE_FALSE(decode({ 1, 2 }));                  // truncated
+    REQUIRE_FALSE(decode({ 1, 2, 3, 2, 3, 'a' }));    // identifier past the end
+    REQUIRE_FALSE(decode({ 1, 2, 3, 2, 5, 'a', 'b' })); // alphanumeric flagged numeric
+    REQUIRE_FALSE(decode({ 1, 2, 3, 2, 5, '0', '1' })); // leading zero
+    REQUIRE_FALSE(decode({ 1, 2, 3, 2, 4, 'a', '.' })); // dot inside identifier
+    REQUIRE_FALSE(decode({ 1, 2, 3, 1, 2, 'a', '.' })); // empty build identifier
+    REQUIRE_FALSE(decode({ 1, 2, 3, 2, 0 }));         // empty identifier
+
+    version<std::uint8_t, std::uint8_t, std::uint8_t> small;
+    const std::string out_of_range = { 1, '\x80', 2, 3, 0 };
+    REQUIRE(deserialize(out_of_range.data(), out_of_range.data() + out_of_range.size(), small).ec == std::errc::result_out_of_range);
+  }
+
+  SECTION("range set round trip") {
+    constexpr std::string_view ranges[] = {
+      ">=1.0.0 <2.0.0 || >3.2.1",
+      "^1.2.3-beta.2",
+      "1.2.3 - 2.0.0",
+      "=1.2.3+build.1",
+      "*",
+    };
+    constexpr std::string_view versions[] = { "0.1.0", "1.2.3-beta.3", "1.2.3", "1.5.0", "2.0.0", "3.3.0" };
+
+    for (auto range_str : ranges) {
+      range_set<> range;
+      REQUIRE(parse(range_str, range));
+
+      std::array<char, 256> buffer{};
+      const auto written = serialize(buffer.data(), buffer.data() + buffer.size(), range);
+      REQUIRE(written);
+
+      range_set<> decoded;
+      const auto read = deserialize(buffer.data(), static_cast<const char*>(written.ptr), decoded);
+      REQUIRE(read);
+      REQUIRE(read.ptr == written.ptr);
+      REQUIRE(decoded.to_string() == range.to_string());
+
+      for (auto version_str : versions) {
+        version<> v;
+        REQUIRE(parse(version_str, v));
+        REQUIRE(decoded.contains(v) == range.contains(v));
+        REQUIRE(decoded.contains(v, version_compare_option::include_prerelease) == range.contains(v, version_compare_option::include_prerelease));
+      }
+    }
+  }
+
+  SECTION("invalid range set") {
+    range_set<> range;
+    const std::string bad_operator = { 1, 1, 7, 1, 2, 3, 0 };
+    REQUIRE_FALSE(deserialize(bad_operator.data(), bad_operator.data() + bad_operator.size(), range));
+    const std::string truncated = { 2, 1, 0, 1, 2, 3, 0 };
+    REQUIRE_FALSE(deserialize(truncated.data(), truncated.data() + truncated.size(), range));
+  }
+}
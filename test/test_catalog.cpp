@@ -0,0 +1,106 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <array>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+static std::vector<version<>> make_versions() {
+  constexpr std::array<std::string_view, 18> versions = {{
+    {"0.9.0"},
+    {"1.0.0-alpha"},
+    {"1.0.0-beta.2"},
+    {"1.0.0"},
+    {"1.2.3-alpha.3"},
+    {"1.2.3-alpha.7"},
+    {"1.2.3"},
+    {"1.2.4"},
+    {"1.3.0-rc.1"},
+    {"1.4.6"},
+    {"2.0.0-alpha.1"},
+    {"2.0.0-alpha.5"},
+    {"2.0.0-alpha.10"},
+    {"2.1.0-rc.1"},
+    {"2.1.0"},
+    {"3.4.5-alpha.9"},
+    {"3.4.5"},
+    {"1.2.3+build"}
+  }};
+
+  std::vector<version<>> result;
+  for (auto str : versions) {
+    version v;
+    REQUIRE(parse(str, v));
+    result.push_back(v);
+  }
+  return result;
+}
+
+TEST_CASE("catalog") {
+  const catalog<> cat{make_versions()};
+
+  for (std::size_t i = 1; i < cat.size(); ++i) {
+    REQUIRE(cat[i - 1] <= cat[i]);
+  }
+
+  constexpr std::array<std::string_view, 12> ranges = {{
+    {">=1.0.0 <2.0.0"},
+    {">1.2.3-alpha.3"},
+    {">=1.2.3-alpha.7 <2.0.0"},
+    {">1.2.3 <2.0.0-alpha.10"},
+    {">1.2.3 <2.0.0-alpha.1 || <=2.0.0-alpha.5"},
+    {"<=2.0.0-alpha.4"},
+    {"1.2.3"},
+    {"1.2.7 || >=1.2.9 <2.0.0"},
+    {">=3.4.5-alpha.1 || <1.0.0"},
+    {">5.0.0"},
+    {">2.0.0 <1.0.0"},
+    {"<=1.0.0-beta.2 >=1.0.0-alpha"}
+  }};
+
+  for (auto str : ranges) {
+    range_set range;
+    REQUIRE(parse(str, range));
+
+    for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+      INFO(str << " : " << static_cast<int>(option));
+
+      std::vector<bool> expected(cat.size());
+      for (std::size_t i = 0; i < cat.size(); ++i) {
+        expected[i] = range.contains(cat[i], option);
+      }
+
+      REQUIRE(cat.satisfying_bitmap(range, option) == expected);
+
+      std::vector<bool> from_intervals(cat.size());
+      std::size_t previous_last = 0;
+      for (const auto& [first, last] : cat.satisfying(range, option)) {
+        REQUIRE(first < last);
+        REQUIRE((previous_last == 0 || previous_last < first));
+        previous_last = last;
+        for (std::size_t i = first; i < last; ++i) {
+          from_intervals[i] = true;
+        }
+      }
+      REQUIRE(from_intervals == expected);
+
+      const auto first = std::find(expected.begin(), expected.end(), true);
+      const auto last = std::find(expected.rbegin(), expected.rend(), true);
+      if (first == expected.end()) {
+        REQUIRE(cat.min_satisfying(range, option) == cat.end());
+        REQUIRE(cat.max_satisfying(range, option) == cat.end());
+      } else {
+        REQUIRE(cat.min_satisfying(range, option) - cat.begin() == first - expected.begin());
+        REQUIRE(cat.end() - cat.max_satisfying(range, option) == last - expected.rbegin() + 1);
+      }
+    }
+  }
+
+  SECTION("rank") {
+    version v;
+    REQUIRE(parse("1.2.3", v));
+    REQUIRE(cat[cat.rank(v)] == v);
+    REQUIRE(parse("9.9.9", v));
+    REQUIRE(cat.rank(v) == cat.size());
+  }
+}
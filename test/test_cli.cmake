@@ -0,0 +1,30 @@
+# Smoke test of the semver command-line tool: cmake -DSEMVER=<tool> -DWORK_DIR=<dir> -P test_cli.cmake
+
+set(INPUT ${WORK_DIR}/test_cli_input.txt)
+file(WRITE ${INPUT} "1.3.0\n1.0.0\nnot-a-version\n2.0.0-rc.1\n1.2.3+build.1\n2.0.0\n")
+
+function(expect_output expected_status expected_output)
+    execute_process(COMMAND ${SEMVER} ${ARGN}
+                    INPUT_FILE ${INPUT}
+                    OUTPUT_VARIABLE output
+                    ERROR_QUIET
+                    RESULT_VARIABLE status)
+    if(NOT status EQUAL expected_status OR NOT output STREQUAL expected_output)
+        message(FATAL_ERROR "semver ${ARGN}: exit ${status}, output:\n${output}\nexpected exit ${expected_status}, output:\n${expected_output}")
+    endif()
+endfunction()
+
+expect_output(0 "1.0.0\n1.2.3+build.1\n1.3.0\n2.0.0-rc.1\n2.0.0\n" sort)
+expect_output(1 "1.3.0\n1.0.0\n2.0.0-rc.1\n1.2.3+build.1\n2.0.0\n" valid)
+expect_output(0 "1.3.0\n2.0.0\n" filter ">=1.3.0")
+expect_output(0 "1.3.0\n2.0.0-rc.1\n2.0.0\n" filter ">=1.3.0" --include-prerelease)
+expect_output(0 "1.3.0\n" max "^1.0.0")
+expect_output(1 "" max ">=3.0.0")
+expect_output(2 "" filter ">=1.3.0 garbage")
+expect_output(2 "" filter)
+
+# an explicit --threads applies below the parallel threshold too
+expect_output(0 "1.0.0\n1.2.3+build.1\n1.3.0\n2.0.0-rc.1\n2.0.0\n" sort --threads 3)
+expect_output(0 "1.0.0\n1.2.3+build.1\n1.3.0\n2.0.0-rc.1\n2.0.0\n" sort --threads 64)
+expect_output(0 "1.3.0\n2.0.0\n" filter ">=1.3.0" --threads 2)
+expect_output(0 "1.3.0\n" max "^1.0.0" --threads 0)
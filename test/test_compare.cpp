@@ -0,0 +1,88 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+static int sign(int value) {
+  return (value > 0) - (value < 0);
+}
+
+TEST_CASE("compare strings") {
+  SECTION("agrees with parsed comparison") {
+    for (auto lhs : valid_versions) {
+      for (auto rhs : valid_versions) {
+        INFO(lhs << " : " << rhs);
+
+        version lhs_version;
+        REQUIRE(parse(lhs, lhs_version));
+        version rhs_version;
+        REQUIRE(parse(rhs, rhs_version));
+
+        int result = 42;
+        REQUIRE(compare(lhs, rhs, result));
+        REQUIRE(result == sign(detail::compare_parsed(lhs_version, rhs_version, version_compare_option::include_prerelease)));
+      }
+    }
+  }
+
+  SECTION("prerelease precedence") {
+    constexpr std::array<std::string_view, 8> versions = {{
+      {"1.0.0-alpha"},
+      {"1.0.0-alpha.1"},
+      {"1.0.0-alpha.beta"},
+      {"1.0.0-beta"},
+      {"1.0.0-beta.2"},
+      {"1.0.0-beta.11"},
+      {"1.0.0-rc.1"},
+      {"1.0.0"}
+    }};
+
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+      for (std::size_t j = 0; j < versions.size(); ++j) {
+        INFO(versions[i] << " : " << versions[j]);
+        int result = 42;
+        REQUIRE(compare(versions[i], versions[j], result));
+        REQUIRE(result == (i > j) - (i < j));
+      }
+    }
+  }
+
+  SECTION("build metadata is ignored") {
+    int result = 42;
+    REQUIRE(compare("1.2.3-rc.1+build.1", "1.2.3-rc.1+build.2", result));
+    REQUIRE(result == 0);
+  }
+
+  SECTION("invalid input") {
+    constexpr std::string_view valid_version = "1.2.3";
+
+    for (auto invalid : invalid_versions) {
+      INFO(invalid);
+
+      int result = 42;
+      auto res = compare(invalid, valid_version, result);
+      REQUIRE_FALSE(res);
+      REQUIRE(res.ptr >= invalid.data());
+      REQUIRE(res.ptr <= invalid.data() + invalid.size());
+
+      res = compare(valid_version, invalid, result);
+      REQUIRE_FALSE(res);
+      REQUIRE(result == 42);
+    }
+  }
+
+  SECTION("invalid suffix after decided order") {
+    int result = 42;
+    REQUIRE_FALSE(compare("1.0.0", "2.0.0-01", result));
+    REQUIRE_FALSE(compare("2.0.0+", "1.0.0", result));
+    REQUIRE(result == 42);
+  }
+
+  SECTION("out of range") {
+    int result = 42;
+    const auto res = compare("99999999999.0.0", "1.0.0", result);
+    REQUIRE_FALSE(res);
+    REQUIRE(res.ec == std::errc::result_out_of_range);
+  }
+}
@@ -0,0 +1,149 @@
+#include <semver_concurrent.hpp>
+#include <catch.hpp>
+#include <array>
+#include <string>
+#include <thread>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+TEST_CASE("parse cache") {
+  SECTION("versions") {
+    parse_cache<version<>> cache;
+    std::shared_ptr<const version<>> first;
+    REQUIRE(cache.parse("1.2.3-rc.1", first));
+    REQUIRE(first->prerelease_tag() == "rc.1");
+
+    std::shared_ptr<const version<>> second;
+    REQUIRE(cache.parse("1.2.3-rc.1", second));
+    REQUIRE(first == second);
+    REQUIRE(cache.size() == 1);
+
+    for (auto str : invalid_versions) {
+      std::shared_ptr<const version<>> v;
+      REQUIRE_FALSE(cache.parse(str, v));
+      REQUIRE(v == nullptr);
+    }
+    REQUIRE(cache.size() == 1);
+  }
+
+  SECTION("ranges") {
+    parse_cache<range_set<>> cache;
+    constexpr std::string_view str = ">=1.0.0 <2.0.0";
+    std::shared_ptr<const range_set<>> range;
+    const auto result = cache.parse(str, range);
+    REQUIRE(result);
+    REQUIRE(result.ptr == str.data() + str.size());
+
+    version v;
+    REQUIRE(parse("1.5.0", v));
+    REQUIRE(range->contains(v));
+
+    std::shared_ptr<const range_set<>> cached;
+    REQUIRE(cache.parse(str, cached).ptr == str.data() + str.size());
+    REQUIRE(range == cached);
+  }
+
+  SECTION("bounded") {
+    parse_cache<version<>> cache{8, 2};
+    for (int i = 0; i < 100; ++i) {
+      const std::string str = "1.0." + std::to_string(i);
+      std::shared_ptr<const version<>> v;
+      REQUIRE(cache.parse(str, v));
+      REQUIRE(v->patch() == i);
+      REQUIRE(cache.size() <= 8);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+      const std::string str = "1.0." + std::to_string(i);
+      std::shared_ptr<const version<>> v;
+      REQUIRE(cache.parse(str, v));
+      REQUIRE(v->to_string() == str);
+    }
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+  }
+
+  SECTION("threads") {
+    parse_cache<version<>> cache{16};
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < 1000; ++i) {
+          const auto str = valid_versions[static_cast<std::size_t>(i) % valid_versions.size()];
+          std::shared_ptr<const version<>> v;
+          if (!cache.parse(str, v) || v->to_string() != str) {
+            ++failures;
+          }
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    REQUIRE(failures == 0);
+    REQUIRE(cache.size() <= 16);
+  }
+}
+
+TEST_CASE("match matrix") {
+  std::vector<version<>> versions;
+  for (int i = 0; i < 3; ++i) {
+    for (auto str : valid_versions) {
+      version<> v;
+      REQUIRE(parse(str, v));
+      versions.push_back(v);
+    }
+  }
+  // enough columns for several tiles
+  for (int major = 0; major < 5; ++major) {
+    for (int minor = 0; minor < 40; ++minor) {
+      for (int patch = 0; patch < 50; ++patch) {
+        version<> v;
+        REQUIRE(parse(std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch) + (patch % 7 == 0 ? "-rc.1" : ""), v));
+        versions.push_back(v);
+      }
+    }
+  }
+  const version_table<> table{versions.begin(), versions.end()};
+
+  constexpr std::array<std::string_view, 8> range_strings = {{
+    {">=1.0.0 <2.0.0"},
+    {">1.0.0-alpha"},
+    {"<=1.0.0-rc.1 || >=2.0.0"},
+    {"*"},
+    {">=1.2.7-rc.1 <1.3.0 || 3.1.14-rc.1"},
+    {">2.0.0 <1.0.0"},
+    {"<0.5.0"},
+    {">=4.39.0"}
+  }};
+
+  std::vector<range_set<>> ranges;
+  for (int i = 0; i < 5; ++i) {
+    for (auto str : range_strings) {
+      range_set<> r;
+      REQUIRE(parse(str, r));
+      ranges.push_back(r);
+    }
+  }
+
+  for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+    for (unsigned threads : {1U, 4U, 0U}) {
+      const match_matrix matrix = match(table, ranges, option, threads);
+      REQUIRE(matrix.rows() == ranges.size());
+      REQUIRE(matrix.columns() == versions.size());
+
+      bool same = true;
+      for (std::size_t row = 0; row < ranges.size(); ++row) {
+        for (std::size_t column = 0; column < versions.size(); ++column) {
+          same = same && matrix.test(row, column) == ranges[row].contains(versions[column], option);
+        }
+      }
+      REQUIRE(same);
+    }
+  }
+}
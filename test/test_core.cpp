@@ -0,0 +1,99 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <type_traits>
+#include <unordered_set>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+static_assert(std::is_trivially_copyable_v<core_version<>>);
+static_assert(sizeof(core_version<>) == 16);
+static_assert(sizeof(core_version<std::uint16_t, std::uint16_t, std::uint16_t>) == 8);
+
+static constexpr core_version<> parse_core(std::string_view str) {
+  core_version<> v;
+  return parse(str, v) ? v : core_version<>{ 0, 0, 0 };
+}
+
+static_assert(parse_core("1.2.3") == core_version<>{ 1, 2, 3 });
+static_assert(parse_core("1.2.3+build.5") == core_version<>{ 1, 2, 3 });
+static_assert(parse_core("1.10.0") > parse_core("1.9.9"));
+
+TEST_CASE("core version") {
+  SECTION("parse") {
+    core_version<> v;
+    REQUIRE(parse("10.20.30", v));
+    REQUIRE(v.major() == 10);
+    REQUIRE(v.minor() == 20);
+    REQUIRE(v.patch() == 30);
+
+    REQUIRE_FALSE(parse("1.2.3-alpha", v));
+    REQUIRE_FALSE(parse("1.2", v));
+    REQUIRE_FALSE(parse("01.2.3", v));
+    REQUIRE_FALSE(parse("1.2.3+", v));
+    REQUIRE_FALSE(parse("1.2.3 ", v));
+
+    core_version<std::uint8_t, std::uint8_t, std::uint8_t> small;
+    const auto res = parse("1.256.0", small);
+    REQUIRE(res.ec == std::errc::result_out_of_range);
+  }
+
+  SECTION("agrees with version") {
+    for (auto lhs_str : valid_versions) {
+      version<> lhs;
+      REQUIRE(parse(lhs_str, lhs));
+      core_version<> lhs_core;
+      REQUIRE(to_core_version(lhs, lhs_core) == lhs.prerelease_tag().empty());
+      if (!lhs.prerelease_tag().empty()) {
+        continue;
+      }
+
+      REQUIRE(lhs_core.hash() == lhs.hash());
+      REQUIRE(to_version(lhs_core) == lhs);
+
+      for (auto rhs_str : valid_versions) {
+        version<> rhs;
+        REQUIRE(parse(rhs_str, rhs));
+        core_version<> rhs_core;
+        if (to_core_version(rhs, rhs_core)) {
+          REQUIRE((lhs_core < rhs_core) == (lhs < rhs));
+          REQUIRE((lhs_core == rhs_core) == (lhs == rhs));
+        }
+      }
+    }
+  }
+
+  SECTION("hash") {
+    std::unordered_set<core_version<>> set = { { 1, 2, 3 }, { 1, 2, 3 }, { 3, 2, 1 } };
+    REQUIRE(set.size() == 2);
+  }
+
+  SECTION("range contains") {
+    constexpr std::string_view ranges[] = {
+      ">=1.0.0 <2.0.0",
+      ">1.2.3-alpha <=1.2.3",
+      "<1.2.3-rc.1",
+      "=1.2.3 || >3.0.0-0",
+      "^1.2.3",
+      "~1.2",
+      "1.2.x",
+      "1.2.3 - 2.0.0-beta",
+      "*",
+    };
+    constexpr std::string_view versions[] = { "0.1.0", "1.0.0", "1.2.2", "1.2.3", "1.2.9", "1.3.0", "2.0.0", "3.0.0", "3.1.0" };
+
+    for (auto range_str : ranges) {
+      range_set<> range;
+      REQUIRE(parse(range_str, range));
+      for (auto version_str : versions) {
+        version<> v;
+        REQUIRE(parse(version_str, v));
+        core_version<> core;
+        REQUIRE(parse(version_str, core));
+
+        REQUIRE(range.contains(core) == range.contains(v));
+        REQUIRE(range.contains(core, version_compare_option::include_prerelease) == range.contains(v, version_compare_option::include_prerelease));
+      }
+    }
+  }
+}
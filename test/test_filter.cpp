@@ -0,0 +1,58 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <array>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+TEST_CASE("filter") {
+  std::vector<version<>> versions;
+  for (auto str : valid_versions) {
+    version<> v;
+    REQUIRE(parse(str, v));
+    versions.push_back(v);
+  }
+
+  const version_table<> table{versions.begin(), versions.end()};
+  REQUIRE(table.size() == versions.size());
+
+  constexpr std::array<std::string_view, 12> ranges = {{
+    {">=1.0.0 <2.0.0"},
+    {">1.0.0-alpha"},
+    {">=1.0.0-alpha.1 <1.0.0"},
+    {"<=1.0.0-rc.1 || >=2.0.0"},
+    {"1.0.0"},
+    {"=1.0.0-alpha"},
+    {"<1.0.0"},
+    {">2.0.0 <1.0.0"},
+    {"*"},
+    {">=0.0.4 <1.2.3 || >=10.20.30"},
+    {">1.0.0-0.3.7"},
+    {"<1.1.2-prerelease"}
+  }};
+
+  // reused across calls, each of which replaces the previous result
+  std::vector<bool> bitmap;
+  std::vector<std::size_t> rows;
+  for (auto str : ranges) {
+    range_set<> r;
+    REQUIRE(parse(str, r));
+
+    for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+      r.filter(table, bitmap, option);
+      REQUIRE(bitmap.size() == versions.size());
+
+      r.filter(table, rows, option);
+
+      std::vector<std::size_t> expected_rows;
+      for (std::size_t i = 0; i < versions.size(); ++i) {
+        const bool expected = r.contains(versions[i], option);
+        CHECK(bitmap[i] == expected);
+        if (expected) {
+          expected_rows.push_back(i);
+        }
+      }
+      CHECK(rows == expected_rows);
+    }
+  }
+}
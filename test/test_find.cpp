@@ -0,0 +1,90 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+namespace {
+
+std::vector<std::pair<std::size_t, std::string>> find(std::string_view text) {
+  std::vector<std::pair<std::size_t, std::string>> result;
+  const std::size_t count = find_all(text, [&](std::string_view match, const static_version<>& v) {
+    static_version<> expected;
+    REQUIRE(parse(match, expected));
+    REQUIRE(v == expected);
+    result.emplace_back(static_cast<std::size_t>(match.data() - text.data()), std::string{ match });
+  });
+  REQUIRE(count == result.size());
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("find all") {
+  SECTION("versions in text") {
+    const std::string_view text = "FROM node:18.2.0-alpine AS build\n"
+                                  "lodash@4.17.21, react v18.2.0 and 1.0.0-rc.1+build.5.\n"
+                                  "Upgraded to 2.0.0-beta.1. (3.4.5)";
+    const std::vector<std::pair<std::size_t, std::string>> expected = {
+      { 10, "18.2.0-alpine" },
+      { 40, "4.17.21" },
+      { 56, "18.2.0" },
+      { 67, "1.0.0-rc.1+build.5" },
+      { 99, "2.0.0-beta.1" },
+      { 114, "3.4.5" },
+    };
+    REQUIRE(find(text) == expected);
+  }
+
+  SECTION("not versions") {
+    constexpr std::string_view texts[] = {
+      "192.168.0.1",
+      "1.2",
+      "python3.11.4",
+      "dev1.2.3",
+      "01.2.3",
+      "1.02.3",
+      "1.2.3a",
+      "1.2.3-01",
+      "a.1.2.3",
+      "99999999999.0.0",
+      "...",
+      ".",
+      "",
+    };
+    for (auto text : texts) {
+      INFO(text);
+      REQUIRE(find(text).empty());
+    }
+  }
+
+  SECTION("edges") {
+    REQUIRE(find("1.2.3") == std::vector<std::pair<std::size_t, std::string>>{ { 0, "1.2.3" } });
+    REQUIRE(find("v1.2.3") == std::vector<std::pair<std::size_t, std::string>>{ { 1, "1.2.3" } });
+    REQUIRE(find("1.2.3-") == std::vector<std::pair<std::size_t, std::string>>{ { 0, "1.2.3" } });
+    REQUIRE(find("1.2.3 1.2.3") == std::vector<std::pair<std::size_t, std::string>>{ { 0, "1.2.3" }, { 6, "1.2.3" } });
+    REQUIRE(find("1.2.3.4 5.6.7") == std::vector<std::pair<std::size_t, std::string>>{ { 8, "5.6.7" } });
+    REQUIRE(find("1.x-1.2.3") == std::vector<std::pair<std::size_t, std::string>>{ { 4, "1.2.3" } });
+  }
+
+  SECTION("long run") {
+    // every `1.1` is a candidate of the same run, which used to be rescanned for each of them
+    std::string text;
+    for (int i = 0; i < 100000; ++i) {
+      text += "1.1-";
+    }
+    const std::size_t offset = text.size();
+    text += "1.2.3";
+    REQUIRE(find(text) == std::vector<std::pair<std::size_t, std::string>>{ { offset, "1.2.3" } });
+  }
+
+  SECTION("every valid version") {
+    for (auto str : valid_versions) {
+      const std::string text = "x " + std::string{ str } + " y";
+      REQUIRE(find(text) == std::vector<std::pair<std::size_t, std::string>>{ { 2, std::string{ str } } });
+    }
+  }
+}
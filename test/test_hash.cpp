@@ -0,0 +1,57 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <unordered_set>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+TEST_CASE("hash") {
+  SECTION("equal versions have equal hashes") {
+    for (auto str : valid_versions) {
+      version lhs;
+      REQUIRE(parse(str, lhs));
+      version rhs;
+      REQUIRE(parse(str, rhs));
+
+      REQUIRE(lhs.hash() == rhs.hash());
+      REQUIRE(std::hash<version<>>{}(lhs) == lhs.hash());
+    }
+  }
+
+  SECTION("build metadata is ignored") {
+    version lhs;
+    REQUIRE(parse("1.2.3-rc.1+build.1", lhs));
+    version rhs;
+    REQUIRE(parse("1.2.3-rc.1+build.2", rhs));
+
+    REQUIRE(lhs == rhs);
+    REQUIRE(lhs.hash() == rhs.hash());
+  }
+
+  SECTION("default constructed") {
+    version lhs;
+    version rhs;
+    REQUIRE(parse("0.1.0", rhs));
+    REQUIRE(lhs.hash() == rhs.hash());
+
+    REQUIRE(parse("1.2.3-alpha", lhs));
+    REQUIRE(parse("0.1.0", lhs));
+    REQUIRE(lhs.hash() == rhs.hash());
+  }
+
+  SECTION("unordered set") {
+    std::unordered_set<version<>> versions;
+    for (auto str : valid_versions) {
+      version v;
+      REQUIRE(parse(str, v));
+      versions.insert(v);
+    }
+
+    version v;
+    REQUIRE(parse("2.0.0+another.build", v));
+    REQUIRE(versions.count(v) == 1);
+
+    REQUIRE(parse("2.0.0-rc.2", v));
+    REQUIRE(versions.count(v) == 0);
+  }
+}
@@ -0,0 +1,161 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <string>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+namespace {
+
+// Feeds `text` split at every pair of positions and collects what comes out.
+template <typename T, typename F>
+void for_each_split(std::string_view text, F&& check) {
+  for (std::size_t i = 0; i <= text.size(); ++i) {
+    for (std::size_t j = i; j <= text.size(); ++j) {
+      // separate buffers, so nothing can rely on the pieces being adjacent
+      const std::string pieces[] = { std::string{ text.substr(0, i) }, std::string{ text.substr(i, j - i) }, std::string{ text.substr(j) } };
+      incremental_parser<T> parser;
+      std::vector<T> values;
+      bool ok = true;
+      for (const auto& piece : pieces) {
+        ok = parser.feed(piece, [&](T& v) { values.push_back(std::move(v)); }) && ok;
+      }
+      ok = parser.finish([&](T& v) { values.push_back(std::move(v)); }) && ok;
+      check(ok, values);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("incremental parser") {
+  SECTION("versions agree with parse") {
+    for (auto str : valid_versions) {
+      version<> expected;
+      REQUIRE(parse(str, expected));
+      for_each_split<version<>>(str, [&](bool ok, const std::vector<version<>>& values) {
+        REQUIRE(ok);
+        REQUIRE(values.size() == 1);
+        REQUIRE(values[0].to_string() == str);
+        REQUIRE(values[0] == expected);
+        REQUIRE(values[0].hash() == expected.hash());
+      });
+    }
+
+    for (auto str : invalid_versions) {
+      version<> expected;
+      if (str.empty() || parse(str, expected)) {
+        continue;
+      }
+      INFO(str);
+      for_each_split<version<>>(str, [&](bool ok, const std::vector<version<>>& values) {
+        // whitespace separates versions, so an invalid one may only leave valid pieces
+        if (str.find(' ') == std::string_view::npos) {
+          REQUIRE_FALSE(ok);
+          REQUIRE(values.empty());
+        }
+      });
+    }
+  }
+
+  SECTION("many versions") {
+    const std::string text = " 1.2.3\n2.0.0-rc.1+build.5\t\r\n10.20.30 ";
+    for_each_split<version<>>(text, [&](bool ok, const std::vector<version<>>& values) {
+      REQUIRE(ok);
+      REQUIRE(values.size() == 3);
+      REQUIRE(values[1].to_string() == "2.0.0-rc.1+build.5");
+    });
+  }
+
+  SECTION("errors and recovery") {
+    incremental_parser<version<>> parser;
+    std::vector<std::string> values;
+    const auto collect = [&](version<>& v) { values.push_back(v.to_string()); };
+
+    const std::string text = "1.2.3 1.02.3 4.5.6 1.2.3-01 7.8.9";
+    auto result = parser.feed(text, collect);
+    REQUIRE(result.ec == std::errc::invalid_argument);
+    REQUIRE(result.ptr == text.data() + 9);
+
+    result = parser.feed(std::string_view{ result.ptr + 1 }, collect);
+    REQUIRE_FALSE(result);
+    REQUIRE(*result.ptr == ' ');
+    REQUIRE(parser.feed(std::string_view{ result.ptr + 1 }, collect));
+    REQUIRE(parser.finish(collect));
+    REQUIRE(values == std::vector<std::string>{ "1.2.3", "4.5.6", "7.8.9" });
+
+    incremental_parser<version<std::uint8_t, std::uint8_t, std::uint8_t>> small_parser;
+    REQUIRE(small_parser.feed("1.256.0", [](auto&) {}).ec == std::errc::result_out_of_range);
+    REQUIRE(small_parser.feed(" 1.2", [](auto&) {}));
+    REQUIRE_FALSE(small_parser.finish([](auto&) {}));
+  }
+
+  SECTION("range sets agree with parse") {
+    constexpr std::string_view ranges[] = {
+      ">=1.0.0 <2.0.0 || >3.2.1",
+      "<1.2.3-rc.1||>=2.0.0",
+      ">=1.2.3<2.0.0",
+      "^1.2.3-beta.2",
+      "~1.2",
+      "^0.0",
+      "1.x",
+      "*",
+      "<= 1.2 >= 1.0",
+      "1.2.3 - 2.0.0-beta",
+      "1.2 - 2",
+      "=1.2.3+build.1",
+      "> 1.2.3 < 2.0.0",
+    };
+    constexpr std::string_view versions[] = { "0.1.0", "1.0.0", "1.2.2", "1.2.3-beta.3", "1.2.3", "1.2.9", "1.3.0", "2.0.0-beta", "2.0.0", "2.5.0", "3.3.0" };
+
+    for (auto str : ranges) {
+      INFO(str);
+      range_set<> expected;
+      REQUIRE(parse(str, expected));
+      for_each_split<range_set<>>(str, [&](bool ok, const std::vector<range_set<>>& values) {
+        REQUIRE(ok);
+        REQUIRE(values.size() == 1);
+        REQUIRE(values[0].to_string() == expected.to_string());
+        for (auto version_str : versions) {
+          version<> v;
+          REQUIRE(parse(version_str, v));
+          REQUIRE(values[0].contains(v) == expected.contains(v));
+          REQUIRE(values[0].contains(v, version_compare_option::include_prerelease) == expected.contains(v, version_compare_option::include_prerelease));
+        }
+      });
+    }
+  }
+
+  SECTION("range sets per line") {
+    const std::string text = "\n>=1.0.0 <2.0.0\r\n   \n^2.1 || 3.x\n>4.0.0";
+    for_each_split<range_set<>>(text, [&](bool ok, const std::vector<range_set<>>& values) {
+      REQUIRE(ok);
+      REQUIRE(values.size() == 3);
+      REQUIRE(values[0].to_string() == ">=1.0.0 <2.0.0");
+      REQUIRE(values[1].to_string() == ">=2.1.0 <3.0.0-0 || >=3.0.0 <4.0.0-0");
+      REQUIRE(values[2].to_string() == ">4.0.0");
+    });
+  }
+
+  SECTION("invalid range sets") {
+    constexpr std::string_view lines[] = { "1.2.3 ||", "|| 1.2.3", "1.2.3 -", "1.2.3 - ", "1.2.3 -2.0.0", "1.2-beta", "1.x.3", ">=", "^^1.2.3", "1.2.3 |", "1.2.3\r1",
+                                           "1x", "x0", "1.2*", "1.2.3x", "1.01" };
+    for (auto line : lines) {
+      INFO(line);
+      for_each_split<range_set<>>(line, [&](bool ok, const std::vector<range_set<>>& values) {
+        REQUIRE_FALSE(ok);
+        REQUIRE(values.empty());
+      });
+    }
+
+    incremental_parser<range_set<>> parser;
+    std::vector<std::string> values;
+    const std::string text = "1.2.3 ||\n>=2.0.0";
+    const auto result = parser.feed(text, [&](range_set<>& r) { values.push_back(r.to_string()); });
+    REQUIRE(result.ptr == text.data() + 8);
+    REQUIRE(parser.feed(std::string_view{ result.ptr + 1 }, [&](range_set<>& r) { values.push_back(r.to_string()); }));
+    REQUIRE(parser.finish([&](range_set<>& r) { values.push_back(r.to_string()); }));
+    REQUIRE(values == std::vector<std::string>{ ">=2.0.0" });
+  }
+}
@@ -0,0 +1,97 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <array>
+#include <random>
+#include <string>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+TEST_CASE("range index") {
+  std::vector<version<>> versions;
+  for (auto str : valid_versions) {
+    version<> v;
+    REQUIRE(parse(str, v));
+    versions.push_back(v);
+  }
+
+  constexpr std::array<std::string_view, 5> tags = {{{""}, {""}, {"alpha"}, {"beta.2"}, {"rc.1"}}};
+  constexpr std::array<std::string_view, 6> operators = {{{""}, {"="}, {"<"}, {"<="}, {">"}, {">="}}};
+
+  // the bounds themselves, where inclusive and exclusive differ
+  for (int major = 0; major < 3; ++major) {
+    for (int minor = 0; minor < 3; ++minor) {
+      for (int patch = 0; patch < 3; ++patch) {
+        for (auto tag : tags) {
+          version<> v;
+          REQUIRE(parse(std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch) + (tag.empty() ? "" : "-" + std::string{tag}), v));
+          versions.push_back(v);
+        }
+      }
+    }
+  }
+
+  std::mt19937 rng{1234};
+  const auto pick = [&](int n) { return static_cast<int>(rng() % static_cast<unsigned>(n)); };
+  const auto random_range = [&] {
+    std::string str;
+    for (int i = 0, ranges = 1 + pick(3); i < ranges; ++i) {
+      if (i > 0) {
+        str += " || ";
+      }
+      for (int j = 0, comparators = 1 + pick(2); j < comparators; ++j) {
+        if (j > 0) {
+          str += " ";
+        }
+        str += std::string{operators[pick(6)]} + std::to_string(pick(3)) + "." + std::to_string(pick(3)) + "." + std::to_string(pick(3));
+        if (auto tag = tags[pick(5)]; !tag.empty()) {
+          str += "-" + std::string{tag};
+        }
+      }
+    }
+
+    range_set<> r;
+    REQUIRE(parse(str, r));
+    return r;
+  };
+
+  range_index<> index;
+  std::vector<bool> live;
+  const auto check = [&] {
+    for (const auto& v : versions) {
+      for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+        std::vector<range_index<>::id_type> expected;
+        for (std::size_t id = 0; id < live.size(); ++id) {
+          if (live[id] && index[id].contains(v, option)) {
+            expected.push_back(id);
+          }
+        }
+        REQUIRE(index.ranges_containing(v, option) == expected);
+      }
+    }
+  };
+
+  for (int i = 0; i < 300; ++i) {
+    const auto id = index.insert(random_range());
+    REQUIRE(id == live.size());
+    live.push_back(true);
+  }
+  REQUIRE(index.size() == 300);
+  check();
+
+  for (std::size_t id = 0; id < live.size(); id += 2) {
+    REQUIRE(index.erase(id));
+    REQUIRE_FALSE(index.erase(id));
+    live[id] = false;
+  }
+  REQUIRE(index.size() == 150);
+  check();
+
+  for (int i = 0; i < 100; ++i) {
+    const auto id = index.insert(random_range());
+    REQUIRE(id < live.size());
+    REQUIRE_FALSE(live[id]);
+    live[id] = true;
+  }
+  check();
+}
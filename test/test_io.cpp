@@ -0,0 +1,172 @@
+#include <semver_io.hpp>
+#include <catch.hpp>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+namespace {
+
+constexpr std::array<std::string_view, 13> left_pad_versions = {{
+  {"1.3.0"},
+  {"0.9.0"},
+  {"1.0.0-alpha"},
+  {"1.0.0-beta.2"},
+  {"1.0.0"},
+  {"1.2.3-alpha.3"},
+  {"1.2.3-alpha.7"},
+  {"1.2.3+build"},
+  {"1.2.4"},
+  {"2.0.0-alpha.1"},
+  {"2.0.0-alpha.10"},
+  {"2.1.0"},
+  {"3.4.5-alpha.9"}
+}};
+
+constexpr std::array<std::string_view, 2> react_versions = {{
+  {"18.2.0"},
+  {"17.0.2"}
+}};
+
+std::vector<char> make_catalog_bytes() {
+  catalog_writer writer;
+  for (auto str : left_pad_versions) {
+    version<long long> v;
+    REQUIRE(parse(str, v));
+    REQUIRE(writer.add("left-pad", v));
+  }
+  for (auto str : react_versions) {
+    version<long long> v;
+    REQUIRE(parse(str, v));
+    REQUIRE(writer.add("react", v));
+  }
+
+  std::vector<char> bytes;
+  REQUIRE(writer.write(bytes) == std::errc{});
+  return bytes;
+}
+
+} // namespace
+
+TEST_CASE("mapped catalog") {
+  const std::vector<char> bytes = make_catalog_bytes();
+  // vector storage is aligned for any fundamental type
+  std::vector<std::uint64_t> aligned((bytes.size() + 7) / 8);
+  std::memcpy(aligned.data(), bytes.data(), bytes.size());
+
+  mapped_catalog cat;
+  REQUIRE(cat.attach(aligned.data(), bytes.size()) == std::errc{});
+  REQUIRE(cat.size() == 2);
+  REQUIRE(cat.find("npm") == mapped_catalog::npos);
+  REQUIRE(cat.find("react") == 1);
+
+  const auto left_pad = cat[cat.find("left-pad")];
+  REQUIRE(left_pad.name() == "left-pad");
+  REQUIRE(left_pad.size() == left_pad_versions.size());
+
+  std::vector<version<long long>> expected_versions;
+  for (auto str : left_pad_versions) {
+    version<long long> v;
+    REQUIRE(parse(str, v));
+    expected_versions.push_back(v);
+  }
+  const catalog<long long> expected{expected_versions};
+
+  SECTION("stored in precedence order") {
+    for (std::size_t i = 0; i < left_pad.size(); ++i) {
+      REQUIRE(left_pad[i].to_string() == expected[i].to_string());
+    }
+    REQUIRE(left_pad[6].build_metadata() == "build");
+  }
+
+  SECTION("numbers are limited to 32 bits") {
+    catalog_writer writer;
+    version<long long> v;
+    REQUIRE(parse("4294967296.0.0", v));
+    REQUIRE_FALSE(writer.add("pkg", v));
+    REQUIRE(parse("4294967295.0.0", v));
+    REQUIRE(writer.add("pkg", v));
+
+    std::vector<char> written;
+    REQUIRE(writer.write(written) == std::errc{});
+    std::vector<std::uint64_t> storage((written.size() + 7) / 8);
+    std::memcpy(storage.data(), written.data(), written.size());
+    mapped_catalog other;
+    REQUIRE(other.attach(storage.data(), written.size()) == std::errc{});
+    REQUIRE(other[0][0].major() == 4294967295U);
+  }
+
+  SECTION("queries agree with catalog") {
+    constexpr std::array<std::string_view, 10> ranges = {{
+      {">=1.0.0 <2.0.0"},
+      {">1.2.3-alpha.3"},
+      {">=1.2.3-alpha.7 <2.0.0"},
+      {">1.2.3 <2.0.0-alpha.10"},
+      {"<=2.0.0-alpha.4 || ^3.4.5-alpha.0"},
+      {"1.2.3"},
+      {"~1.2"},
+      {">5.0.0"},
+      {">2.0.0 <1.0.0"},
+      {"*"}
+    }};
+
+    for (auto str : ranges) {
+      range_set<long long> range;
+      REQUIRE(parse(str, range));
+
+      for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+        INFO(str << " : " << static_cast<int>(option));
+
+        const auto it = expected.max_satisfying(range, option);
+        const std::size_t index = left_pad.max_satisfying(range, option);
+        if (it == expected.end()) {
+          REQUIRE(index == mapped_catalog::npos);
+        } else {
+          REQUIRE(index == static_cast<std::size_t>(it - expected.begin()));
+        }
+
+        std::vector<std::size_t> expected_indices;
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+          if (range.contains(expected[i], option)) {
+            expected_indices.push_back(i);
+          }
+        }
+        std::vector<std::size_t> indices;
+        left_pad.satisfying(range, indices, option);
+        REQUIRE(indices == expected_indices);
+      }
+    }
+  }
+
+  SECTION("file") {
+    const std::string path = "semver_test_catalog.bin";
+    catalog_writer writer;
+    version<> v;
+    REQUIRE(parse("1.2.3", v));
+    REQUIRE(writer.add("pkg", v));
+    REQUIRE(writer.write(path.c_str()) == std::errc{});
+
+    mapped_catalog file;
+    REQUIRE(file.open(path.c_str()) == std::errc{});
+    mapped_catalog moved = std::move(file);
+    REQUIRE(moved.size() == 1);
+    REQUIRE(moved[0][0].to_string() == "1.2.3");
+    moved.close();
+    std::remove(path.c_str());
+
+    REQUIRE(file.open("does-not-exist.bin") != std::errc{});
+  }
+
+  SECTION("rejects corrupt files") {
+    std::vector<std::uint64_t> corrupt = aligned;
+    reinterpret_cast<char*>(corrupt.data())[0] = 'X';
+    mapped_catalog other;
+    REQUIRE(other.attach(corrupt.data(), bytes.size()) == std::errc::invalid_argument);
+    REQUIRE(other.attach(aligned.data(), 16) == std::errc::invalid_argument);
+    REQUIRE(other.attach(aligned.data(), bytes.size() - 1) == std::errc::invalid_argument);
+  }
+}
@@ -0,0 +1,125 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+TEST_CASE("version pool") {
+  SECTION("deduplication") {
+    version_pool<> pool;
+    std::unordered_set<version<>> distinct;
+    for (auto str : valid_versions) {
+      version v;
+      REQUIRE(parse(str, v));
+      distinct.insert(v);
+
+      version_pool<>::id_type id = 0;
+      REQUIRE(pool.intern(str, id));
+      REQUIRE(pool[id] == v);
+    }
+    REQUIRE(pool.size() == distinct.size());
+
+    version_pool<>::id_type lhs = 0;
+    version_pool<>::id_type rhs = 0;
+    REQUIRE(pool.intern("1.0.0-alpha+beta", lhs));
+    REQUIRE(pool.intern("1.0.0-alpha", rhs));
+    REQUIRE(lhs == rhs);
+
+    version v;
+    REQUIRE(parse("10.20.30+meta", v));
+    version_pool<>::id_type id = 0;
+    REQUIRE(pool.intern(v, id));
+    REQUIRE(pool[id].to_string() == "10.20.30");
+    REQUIRE(pool.size() == distinct.size());
+  }
+
+  SECTION("find") {
+    version_pool<> pool;
+    version_pool<>::id_type id = 0;
+    REQUIRE_FALSE(pool.find("1.2.3", id));
+
+    REQUIRE(pool.intern("1.2.3-rc.1", id));
+    version_pool<>::id_type found = 42;
+    REQUIRE(pool.find("1.2.3-rc.1+build", found));
+    REQUIRE(found == id);
+    REQUIRE_FALSE(pool.find("1.2.3-rc.2", found));
+    REQUIRE_FALSE(pool.find("1.2.3-rc.01", found));
+  }
+
+  SECTION("invalid") {
+    version_pool<> pool;
+    for (auto str : invalid_versions) {
+      version_pool<>::id_type id = 0;
+      REQUIRE_FALSE(pool.intern(str, id));
+    }
+    REQUIRE(pool.empty());
+  }
+
+  SECTION("sort") {
+    version_pool<> pool;
+    std::vector<version_pool<>::id_type> ids;
+    for (auto str : valid_versions) {
+      version_pool<>::id_type id = 0;
+      REQUIRE(pool.intern(str, id));
+      ids.push_back(id);
+    }
+    REQUIRE_FALSE(pool.sorted());
+
+    const auto mapping = pool.sort();
+    REQUIRE(pool.sorted());
+
+    for (std::size_t i = 0; i < valid_versions.size(); ++i) {
+      const auto id = mapping[ids[i]];
+      version v;
+      REQUIRE(parse(valid_versions[i], v));
+      REQUIRE(pool[id] == v);
+
+      version_pool<>::id_type found = 0;
+      REQUIRE(pool.find(valid_versions[i], found));
+      REQUIRE(found == id);
+    }
+
+    for (version_pool<>::id_type i = 1; i < pool.size(); ++i) {
+      REQUIRE(pool[i - 1] < pool[i]);
+    }
+
+    version_pool<>::id_type id = 0;
+    REQUIRE(pool.intern("1000000000.0.0", id));
+    REQUIRE(pool.sorted());
+    REQUIRE(pool.intern("0.0.1", id));
+    REQUIRE_FALSE(pool.sorted());
+  }
+  SECTION("full pool") {
+    // the largest id marks empty slots, so 8-bit ids number 255 versions
+    version_pool<int, int, int, std::uint8_t> pool;
+    REQUIRE(pool.max_size() == 255);
+    for (int i = 0; i < 255; ++i) {
+      const std::string str = "1.0." + std::to_string(i);
+      std::uint8_t id = 0;
+      REQUIRE(pool.intern(str, id));
+      REQUIRE(id == i);
+    }
+
+    std::uint8_t id = 0;
+    const std::string str = "2.0.0";
+    const auto result = pool.intern(str, id);
+    REQUIRE(result.ec == std::errc::value_too_large);
+    REQUIRE(result.ptr == str.data());
+
+    version<> v;
+    REQUIRE(parse(str, v));
+    REQUIRE(pool.intern(v, id).ec == std::errc::value_too_large);
+    REQUIRE_FALSE(pool.find(str, id));
+    REQUIRE(pool.size() == 255);
+
+    // versions already in the pool still intern
+    REQUIRE(parse("1.0.254+build", v));
+    REQUIRE(pool.intern(v, id));
+    REQUIRE(id == 254);
+    REQUIRE(pool.intern("1.0.0", id));
+    REQUIRE(id == 0);
+  }
+}
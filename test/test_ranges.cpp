@@ -1,5 +1,6 @@
 #include <semver.hpp>
 #include <catch.hpp>
+#include <algorithm>
 #include <array>
 
 static void test_parse_and_check(std::string_view range_str, std::string_view ver_str,
@@ -166,3 +167,255 @@ TEST_CASE("ranges with prerelease tags") {
     }
   }
 }
+
+TEST_CASE("prerelease gate and comparators agree in one pass") {
+  constexpr std::array<std::string_view, 6> ranges = {{
+    {">=1.2.0-nightly.0 <1.3.0-0"},
+    {">=1.0.0-rc.2 <=1.1.0-rc.1 || >=2.0.0-0"},
+    {">1.0.0 <2.0.0"},
+    {"1.1.0-rc.1"},
+    {"<1.1.0-rc.2 >1.0.0-rc.1"},
+    {"^1.0.0-rc.1 || ~1.2.0-0"},
+  }};
+  constexpr std::array<std::string_view, 9> versions = {{
+    {"1.0.0-rc.1"}, {"1.0.0-rc.2"}, {"1.0.0"}, {"1.1.0-rc.1"}, {"1.1.0-rc.3"},
+    {"1.2.0-nightly.5"}, {"1.3.0-nightly.1"}, {"2.0.0-alpha"}, {"2.1.0"},
+  }};
+
+  for (const auto range_str : ranges) {
+    semver::range_set<> rs;
+    REQUIRE(semver::parse(range_str, rs));
+    for (const auto ver_str : versions) {
+      INFO(range_str << " : " << ver_str);
+      semver::version<> v;
+      REQUIRE(semver::parse(ver_str, v));
+
+      const bool expected = std::any_of(rs.get_ranges().begin(), rs.get_ranges().end(), [&](const auto& r) {
+        return r.match_at_least_one_comparator_with_prerelease(v) && std::all_of(r.get_comparators().begin(), r.get_comparators().end(), [&](const auto& c) {
+          return c.contains(v);
+        });
+      });
+      REQUIRE(rs.contains(v) == expected);
+    }
+  }
+}
+
+TEST_CASE("explain") {
+  semver::range_set<> rs;
+  REQUIRE(semver::parse(">=1.2.3 <2.0.0 || >=3.0.0-beta <3.1.0", rs));
+  std::array<semver::range_rejection, 2> buffer{};
+
+  const auto explain = [&](std::string_view str, semver::version_compare_option option, std::size_t size) {
+    semver::version<> v;
+    REQUIRE(semver::parse(str, v));
+    const auto result = rs.explain(v, buffer.data(), buffer.data() + size, option);
+    REQUIRE(result.contains == rs.contains(v, option));
+    return result;
+  };
+
+  SECTION("contained") {
+    const auto result = explain("1.5.0", semver::version_compare_option::exclude_prerelease, 2);
+    REQUIRE(result.contains);
+    REQUIRE(result.rejections == 1);
+    REQUIRE(buffer[0].range == 1);
+    REQUIRE(buffer[0].comparator == 0);
+  }
+
+  SECTION("rejecting comparators") {
+    const auto result = explain("2.5.0", semver::version_compare_option::exclude_prerelease, 2);
+    REQUIRE_FALSE(result.contains);
+    REQUIRE(result.rejections == 2);
+    REQUIRE(buffer[0].range == 0);
+    REQUIRE(buffer[0].comparator == 1);
+    REQUIRE_FALSE(buffer[0].prerelease);
+    REQUIRE(buffer[1].range == 1);
+    REQUIRE(buffer[1].comparator == 0);
+  }
+
+  SECTION("prerelease filter") {
+    auto result = explain("1.5.0-rc.1", semver::version_compare_option::exclude_prerelease, 2);
+    REQUIRE_FALSE(result.contains);
+    REQUIRE(buffer[0].prerelease);
+    REQUIRE(buffer[0].comparator == semver::range_rejection::npos);
+    REQUIRE(buffer[1].prerelease);
+    REQUIRE(buffer[1].comparator == 0);
+
+    result = explain("1.5.0-rc.1", semver::version_compare_option::include_prerelease, 2);
+    REQUIRE(result.contains);
+    REQUIRE(result.rejections == 1);
+
+    result = explain("3.0.0-rc.1", semver::version_compare_option::exclude_prerelease, 2);
+    REQUIRE(result.contains);
+  }
+
+  SECTION("short buffer") {
+    buffer[1].range = 42;
+    const auto result = explain("0.1.0", semver::version_compare_option::exclude_prerelease, 1);
+    REQUIRE(result.rejections == 2);
+    REQUIRE(buffer[0].range == 0);
+    REQUIRE(buffer[1].range == 42);
+  }
+}
+
+TEST_CASE("max and min satisfying") {
+  constexpr std::array<std::string_view, 16> strings = {{
+    {"0.9.0"},
+    {"1.0.0-alpha"},
+    {"1.0.0-beta.2"},
+    {"1.0.0"},
+    {"1.2.3-alpha.3"},
+    {"1.2.3-alpha.7"},
+    {"1.2.3"},
+    {"1.2.4"},
+    {"1.3.0-rc.1"},
+    {"1.4.6"},
+    {"2.0.0-alpha.1"},
+    {"2.0.0-alpha.5"},
+    {"2.0.0-alpha.10"},
+    {"2.1.0-rc.1"},
+    {"3.4.5-alpha.9"},
+    {"3.4.5"}
+  }};
+
+  std::vector<semver::version<>> versions;
+  for (auto str : strings) {
+    semver::version v;
+    REQUIRE(semver::parse(str, v));
+    versions.push_back(v);
+  }
+
+  std::vector<semver::version<>> reversed{versions.rbegin(), versions.rend()};
+
+  constexpr std::array<std::string_view, 10> ranges = {{
+    {">=1.0.0 <2.0.0"},
+    {">1.2.3-alpha.3"},
+    {">=1.2.3-alpha.7 <2.0.0"},
+    {">1.2.3 <2.0.0-alpha.10"},
+    {">1.2.3 <2.0.0-alpha.1 || <=2.0.0-alpha.5"},
+    {"<=2.0.0-alpha.4"},
+    {"1.2.7 || >=1.2.9 <2.0.0"},
+    {">=3.4.5-alpha.1 || <1.0.0"},
+    {">5.0.0"},
+    {"<=1.0.0-beta.2 >=1.0.0-alpha"}
+  }};
+
+  for (auto str : ranges) {
+    semver::range_set range;
+    REQUIRE(semver::parse(str, range));
+
+    for (auto option : {semver::version_compare_option::exclude_prerelease, semver::version_compare_option::include_prerelease}) {
+      INFO(str << " : " << static_cast<int>(option));
+
+      auto expected_min = versions.end();
+      auto expected_max = versions.end();
+      for (auto it = versions.begin(); it != versions.end(); ++it) {
+        if (range.contains(*it, option)) {
+          expected_min = expected_min == versions.end() ? it : expected_min;
+          expected_max = it;
+        }
+      }
+
+      REQUIRE(semver::max_satisfying(versions.begin(), versions.end(), range, option, semver::sequence_order::sorted) == expected_max);
+      REQUIRE(semver::min_satisfying(versions.begin(), versions.end(), range, option, semver::sequence_order::sorted) == expected_min);
+
+      // without sequence_order::sorted the input may be in any order
+      const auto max = semver::max_satisfying(reversed.begin(), reversed.end(), range, option);
+      const auto min = semver::min_satisfying(reversed.begin(), reversed.end(), range, option);
+      if (expected_max == versions.end()) {
+        REQUIRE(max == reversed.end());
+        REQUIRE(min == reversed.end());
+      } else {
+        REQUIRE(*max == *expected_max);
+        REQUIRE(*min == *expected_min);
+      }
+    }
+  }
+}
+
+TEST_CASE("range sugar") {
+  constexpr std::array<std::array<std::string_view, 2>, 33> ranges = {{
+    {{"^1.2.3", ">=1.2.3 <2.0.0-0"}},
+    {{"^1.2.3-beta.2", ">=1.2.3-beta.2 <2.0.0-0"}},
+    {{"^0.2.3", ">=0.2.3 <0.3.0-0"}},
+    {{"^0.0.3", ">=0.0.3 <0.0.4-0"}},
+    {{"^1.2", ">=1.2.0 <2.0.0-0"}},
+    {{"^1.2.x", ">=1.2.0 <2.0.0-0"}},
+    {{"^0.0", ">=0.0.0 <0.1.0-0"}},
+    {{"^0.0.x", ">=0.0.0 <0.1.0-0"}},
+    {{"^1", ">=1.0.0 <2.0.0-0"}},
+    {{"^0.x", ">=0.0.0 <1.0.0-0"}},
+    {{"^*", "*"}},
+    {{"~1.2.3", ">=1.2.3 <1.3.0-0"}},
+    {{"~1.2", ">=1.2.0 <1.3.0-0"}},
+    {{"~1", ">=1.0.0 <2.0.0-0"}},
+    {{"~ 0.2.3-rc.1", ">=0.2.3-rc.1 <0.3.0-0"}},
+    {{"1.x", ">=1.0.0 <2.0.0-0"}},
+    {{"1.2.X", ">=1.2.0 <1.3.0-0"}},
+    {{"1.*.*", ">=1.0.0 <2.0.0-0"}},
+    {{"*", "*"}},
+    {{"x", "*"}},
+    {{">1", ">=2.0.0"}},
+    {{">1.2", ">=1.3.0"}},
+    {{">=1.2", ">=1.2.0"}},
+    {{"<1.2", "<1.2.0-0"}},
+    {{"<=1.2", "<1.3.0-0"}},
+    {{"=1.2", ">=1.2.0 <1.3.0-0"}},
+    {{">*", "<0.0.0-0"}},
+    {{"<=*", "*"}},
+    {{"1.2.3 - 2.3.4", ">=1.2.3 <=2.3.4"}},
+    {{"1.2 - 2.3.4", ">=1.2.0 <=2.3.4"}},
+    {{"1.2.3 - 2.3", ">=1.2.3 <2.4.0-0"}},
+    {{"1.2.3 - 2", ">=1.2.3 <3.0.0-0"}},
+    {{"^1.2.3 || 1.2.3-alpha - 1.2.3", "1.2.3-alpha - 1.2.3 || ^1.2.3"}}
+  }};
+
+  for (const auto& [sugar, expanded] : ranges) {
+    INFO(sugar);
+    semver::range_set<> r;
+    REQUIRE(semver::parse(sugar, r));
+    semver::range_set<> e;
+    REQUIRE(semver::parse(expanded, e));
+    CHECK(r.to_string() == e.to_string());
+    for (const auto& range : r.get_ranges()) {
+      CHECK(range.get_comparators().size() <= 2);
+    }
+  }
+
+  test_parse_and_check("^1.2.3", "1.9.9");
+  test_parse_and_check_false("^1.2.3", "2.0.0-alpha", semver::version_compare_option::include_prerelease);
+  test_parse_and_check("~1.2.3-beta.2", "1.2.3-beta.4");
+  test_parse_and_check_false("~1.2.3-beta.2", "1.2.4-beta.2");
+  test_parse_and_check("1.x || >=2.5.0 || 5.0.0 - 7.2.3", "7.0.0");
+
+  semver::range_set<> r;
+  CHECK_FALSE(semver::parse("1.x.3", r));
+  CHECK_FALSE(semver::parse("^~1.2.3", r));
+}
+
+TEST_CASE("range leading zeros") {
+  constexpr std::array<std::string_view, 14> ranges = {{
+    {"01.2.3"},
+    {">01.2.3"},
+    {"1.02.3"},
+    {"1.2.03"},
+    {"<=1.2.00"},
+    {"1.01"},
+    {"^01"},
+    {"~1.00"},
+    {"0.x01"},
+    {"x0"},
+    {"2.001x"},
+    {"1x"},
+    {"1.2*"},
+    {"1.2.3 - 01.2.3"}
+  }};
+
+  for (auto range_str : ranges) {
+    INFO(range_str);
+    semver::range_set<> r;
+    CHECK_FALSE(semver::parse(range_str, r));
+  }
+
+  test_parse_and_check("0.1.2", "0.1.2");
+  test_parse_and_check("^0.0.0 || 10.0.0", "10.0.0");
+}
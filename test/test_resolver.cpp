@@ -0,0 +1,257 @@
+#include <semver_resolver.hpp>
+#include <catch.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace semver;
+
+namespace {
+
+version<> v(std::string_view str) {
+  version<> result;
+  REQUIRE(parse(str, result));
+  return result;
+}
+
+std::vector<dependency<>> deps(std::initializer_list<std::pair<std::string_view, std::string_view>> list) {
+  std::vector<dependency<>> result;
+  for (const auto& [package, str] : list) {
+    range_set<> range;
+    REQUIRE(parse(str, range));
+    result.push_back({ std::string{ package }, std::move(range) });
+  }
+  return result;
+}
+
+std::vector<std::pair<std::string, std::string>> selected(const resolution<>& r) {
+  std::vector<std::pair<std::string, std::string>> result;
+  for (const auto& [package, version] : r.packages) {
+    result.emplace_back(package, version.to_string());
+  }
+  return result;
+}
+
+using selection = std::vector<std::pair<std::string, std::string>>;
+
+} // namespace
+
+TEST_CASE("resolve") {
+  memory_registry<> registry;
+  resolution<> result;
+
+  SECTION("no conflicts") {
+    registry.add("foo", v("1.0.0"), deps({ { "bar", "^1.0.0" } }));
+    registry.add("bar", v("1.0.0"));
+    registry.add("bar", v("2.0.0"));
+
+    REQUIRE(resolve(registry, deps({ { "foo", "^1.0.0" } }), result));
+    REQUIRE(selected(result) == selection{ { "bar", "1.0.0" }, { "foo", "1.0.0" } });
+    REQUIRE(result.explanation.empty());
+    REQUIRE(result.conflicts == 0);
+  }
+
+  SECTION("avoids a conflict while deciding") {
+    registry.add("foo", v("1.0.0"));
+    registry.add("foo", v("1.1.0"), deps({ { "bar", "^2.0.0" } }));
+    registry.add("bar", v("1.0.0"));
+    registry.add("bar", v("1.1.0"));
+    registry.add("bar", v("2.0.0"));
+
+    REQUIRE(resolve(registry, deps({ { "foo", "^1.0.0" }, { "bar", "^1.0.0" } }), result));
+    REQUIRE(selected(result) == selection{ { "bar", "1.1.0" }, { "foo", "1.0.0" } });
+  }
+
+  SECTION("conflict resolution") {
+    registry.add("foo", v("1.0.0"));
+    registry.add("foo", v("2.0.0"), deps({ { "bar", "^1.0.0" } }));
+    registry.add("bar", v("1.0.0"), deps({ { "foo", "^1.0.0" } }));
+
+    REQUIRE(resolve(registry, deps({ { "foo", ">=1.0.0" } }), result));
+    REQUIRE(selected(result) == selection{ { "foo", "1.0.0" } });
+    REQUIRE(result.conflicts == 1);
+  }
+
+  SECTION("conflict resolution with a partial satisfier") {
+    registry.add("foo", v("1.0.0"));
+    registry.add("foo", v("1.1.0"), deps({ { "left", "^1.0.0" }, { "right", "^1.0.0" } }));
+    registry.add("left", v("1.0.0"), deps({ { "shared", ">=1.0.0" } }));
+    registry.add("right", v("1.0.0"), deps({ { "shared", "<2.0.0" } }));
+    registry.add("shared", v("2.0.0"));
+    registry.add("shared", v("1.0.0"), deps({ { "target", "^1.0.0" } }));
+    registry.add("target", v("2.0.0"));
+    registry.add("target", v("1.0.0"));
+
+    REQUIRE(resolve(registry, deps({ { "foo", "^1.0.0" }, { "target", "^2.0.0" } }), result));
+    REQUIRE(selected(result) == selection{ { "foo", "1.0.0" }, { "target", "2.0.0" } });
+  }
+
+  SECTION("backjumps over unrelated decisions") {
+    registry.add("a", v("1.0.0"), deps({ { "c", "^1.0.0" } }));
+    registry.add("a", v("2.0.0"), deps({ { "c", "^2.0.0" } }));
+    registry.add("b", v("1.0.0"));
+    registry.add("b", v("2.0.0"));
+    registry.add("c", v("1.0.0"));
+    registry.add("c", v("2.0.0"), deps({ { "d", "^1.0.0" } }));
+
+    REQUIRE(resolve(registry, deps({ { "a", "*" }, { "b", "*" } }), result));
+    REQUIRE(selected(result) == selection{ { "a", "1.0.0" }, { "b", "2.0.0" }, { "c", "1.0.0" } });
+  }
+
+  SECTION("no solution") {
+    registry.add("foo", v("1.0.0"), deps({ { "bar", "^2.0.0" } }));
+    registry.add("bar", v("2.0.0"), deps({ { "baz", "^3.0.0" } }));
+    registry.add("baz", v("1.0.0"));
+    registry.add("baz", v("3.0.0"));
+
+    REQUIRE_FALSE(resolve(registry, deps({ { "foo", "^1.0.0" }, { "baz", "^1.0.0" } }), result));
+    REQUIRE(result.packages.empty());
+    REQUIRE(result.explanation ==
+            "(1) Because no versions of foo match >=1.0.1 <2.0.0 and foo 1.0.0 depends on bar >=2.0.0 <3.0.0, foo >=1.0.0 <2.0.0 requires bar >=2.0.0 <3.0.0.\n"
+            "(2) Because bar 2.0.0 depends on baz >=3.0.0 <4.0.0 and no versions of bar match >=2.0.1 <3.0.0, bar >=2.0.0 <3.0.0 requires baz >=3.0.0 <4.0.0.\n"
+            "(3) Because (1) and (2), foo >=1.0.0 <2.0.0 requires baz >=3.0.0 <4.0.0.\n"
+            "(4) Because (3) and root depends on foo >=1.0.0 <2.0.0, baz >=3.0.0 <4.0.0 is required.\n"
+            "(5) Because (4) and root depends on baz >=1.0.0 <2.0.0, version solving failed.\n");
+  }
+
+  SECTION("unknown packages and versions") {
+    registry.add("foo", v("1.0.0"), deps({ { "missing", "*" } }));
+
+    REQUIRE_FALSE(resolve(registry, deps({ { "foo", "*" } }), result));
+    REQUIRE_FALSE(result.explanation.empty());
+
+    REQUIRE_FALSE(resolve(registry, deps({ { "bar", "^1.0.0" } }), result));
+    REQUIRE(result.explanation == "(1) Because root depends on bar >=1.0.0 <2.0.0 and no versions of bar match >=1.0.0 <2.0.0, version solving failed.\n");
+  }
+
+  SECTION("prereleases") {
+    registry.add("foo", v("1.0.0"));
+    registry.add("foo", v("1.1.0-rc.1"));
+
+    REQUIRE(resolve(registry, deps({ { "foo", "^1.0.0" } }), result));
+    REQUIRE(selected(result) == selection{ { "foo", "1.0.0" } });
+
+    REQUIRE(resolve(registry, deps({ { "foo", "^1.0.0" } }), result, version_compare_option::include_prerelease));
+    REQUIRE(selected(result) == selection{ { "foo", "1.1.0-rc.1" } });
+  }
+
+  SECTION("every constraint holds") {
+    // a chain where each package narrows the next one, with a trap at the top
+    for (int i = 0; i < 20; ++i) {
+      for (int major = 1; major <= 3; ++major) {
+        const std::string name = "p" + std::to_string(i);
+        const std::string next = "p" + std::to_string(i + 1);
+        registry.add(name, v(std::to_string(major) + ".0.0"), i + 1 < 20 ? deps({ { next, major == 3 && i == 10 ? "^9.0.0" : ">=1.0.0" } }) : std::vector<dependency<>>{});
+      }
+    }
+
+    REQUIRE(resolve(registry, deps({ { "p0", "*" } }), result));
+    REQUIRE(result.packages.size() == 20);
+    for (const auto& [package, version] : result.packages) {
+      std::vector<dependency<>> requirements;
+      REQUIRE(registry.dependencies(package, version, requirements));
+      for (const auto& d : requirements) {
+        const auto it = std::find_if(result.packages.begin(), result.packages.end(), [&](const auto& p) { return p.first == d.package; });
+        REQUIRE(it != result.packages.end());
+        REQUIRE(d.range.contains(it->second));
+      }
+    }
+  }
+}
+
+TEST_CASE("mvs resolve") {
+  // module@version -> requirements
+  std::map<std::string, std::vector<requirement<>>> graph;
+  const auto require = [&](const std::string& key, std::initializer_list<std::pair<std::string_view, std::string_view>> list) {
+    for (const auto& [module, str] : list) {
+      graph[key].push_back({ std::string{ module }, v(str) });
+    }
+  };
+  const auto provider = [&](std::string_view module, const version<>& ver, std::vector<requirement<>>& out) {
+    const auto it = graph.find(std::string{ module } + "@" + ver.to_string());
+    if (it != graph.end()) {
+      out.insert(out.end(), it->second.begin(), it->second.end());
+    }
+  };
+  const auto build_list = [](const std::vector<requirement<>>& list) {
+    selection result;
+    for (const auto& r : list) {
+      result.emplace_back(r.module, r.minimum.to_string());
+    }
+    return result;
+  };
+
+  SECTION("highest required version of every module") {
+    require("B@1.2.0", { { "D", "1.3.0" } });
+    require("B@1.3.0", { { "D", "1.3.0" } });
+    require("C@1.2.0", { { "D", "1.4.0" } });
+    require("C@1.3.0", { { "F", "1.1.0" } });
+    require("D@1.3.0", { { "E", "1.2.0" } });
+    require("D@1.4.0", { { "E", "1.2.0" } });
+    require("F@1.1.0", { { "G", "1.1.0" } });
+
+    const auto roots = std::vector<requirement<>>{ { "B", v("1.2.0") }, { "C", v("1.2.0") } };
+    REQUIRE(build_list(mvs_resolve(roots, provider)) == selection{ { "B", "1.2.0" }, { "C", "1.2.0" }, { "D", "1.4.0" }, { "E", "1.2.0" } });
+  }
+
+  SECTION("cycles and prereleases") {
+    require("a@1.0.0", { { "b", "1.0.0-rc.1" } });
+    require("b@1.0.0-rc.1", { { "a", "1.0.0" }, { "b", "1.0.0-rc.2" } });
+    require("b@1.0.0-rc.2", { { "a", "1.0.0" } });
+
+    const auto roots = std::vector<requirement<>>{ { "a", v("1.0.0") }, { "b", v("1.0.0-alpha") } };
+    REQUIRE(build_list(mvs_resolve(roots, provider)) == selection{ { "a", "1.0.0" }, { "b", "1.0.0-rc.2" } });
+  }
+
+  SECTION("same build list on any number of threads") {
+    // appends to a named string, GCC 12 warns about `"m" + std::to_string(i)` at -O2
+    const auto name = [](std::string_view prefix, int n, std::string_view suffix = {}) {
+      std::string result{ prefix };
+      result += std::to_string(n);
+      result += suffix;
+      return result;
+    };
+
+    std::vector<requirement<>> roots;
+    for (int i = 0; i < 1000; ++i) {
+      const std::string module = name("m", i);
+      for (int minor = 0; minor < 3; ++minor) {
+        for (int k = 1; k <= 3 && i + k * 7 < 1000; ++k) {
+          const int target = i + k * 7;
+          graph[module + name("@1.", minor, ".0")].push_back({ name("m", target), v(name("1.", (i + target + minor) % 3, ".0")) });
+        }
+      }
+      if (i < 300) {
+        roots.push_back({ module, v("1.0.0") });
+      }
+    }
+
+    const auto serial = mvs_resolve(roots, provider, 1);
+    REQUIRE(serial.size() == 1000);
+    REQUIRE(build_list(mvs_resolve(roots, provider, 4)) == build_list(serial));
+  }
+
+  SECTION("many versions of one module") {
+    const auto patch = [](int n) {
+      std::string result{ "1.0." };
+      result += std::to_string(n);
+      return result;
+    };
+    for (int i = 0; i < 5000; ++i) {
+      graph["b@" + patch(i)].push_back({ "b", v(patch(i + 1)) });
+      graph["b@" + patch(i)].push_back({ "c", v(patch(i % 7)) });
+    }
+
+    const auto roots = std::vector<requirement<>>{ { "a", v("1.0.0") }, { "b", v("1.0.0") } };
+    REQUIRE(build_list(mvs_resolve(roots, provider, 1)) == selection{ { "a", "1.0.0" }, { "b", "1.0.5000" }, { "c", "1.0.6" } });
+  }
+
+  SECTION("provider errors") {
+    const auto failing = [](std::string_view, const version<>&, std::vector<requirement<>>&) { throw std::runtime_error{ "offline" }; };
+    REQUIRE_THROWS_AS(mvs_resolve(std::vector<requirement<>>{ { "a", v("1.0.0") } }, failing), std::runtime_error);
+  }
+}
@@ -0,0 +1,137 @@
+#include <semver.hpp>
+#include <catch.hpp>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace semver;
+
+static constexpr bool static_satisfies(std::string_view version_str, std::string_view range_str,
+                                       version_compare_option option = version_compare_option::exclude_prerelease) {
+  static_version<> v;
+  static_range_set<32> r;
+  return parse(version_str, v) && parse(range_str, r) && satisfies(v, r, option);
+}
+
+static_assert(static_satisfies("1.2.3", ">=1.0.0 <2.0.0"));
+static_assert(!static_satisfies("2.0.0", ">=1.0.0 <2.0.0"));
+static_assert(static_satisfies("1.9.0", "^1.2.3"));
+static_assert(!static_satisfies("1.3.0-rc.1", "~1.2"));
+static_assert(static_satisfies("1.3.0-rc.1", "~1.3.0-rc.0"));
+static_assert(!static_satisfies("2.0.0-rc.1", "<2.0.0"));
+static_assert(static_satisfies("2.0.0-rc.1", "<2.0.0", version_compare_option::include_prerelease));
+static_assert(static_satisfies("1.0.0-alpha.10", ">1.0.0-alpha.9 || 3.x"));
+static_assert(static_satisfies("3.7.1", ">1.0.0-alpha.9 || 3.x"));
+
+#if __cpp_nontype_template_args >= 201911L && __cpp_consteval >= 201811L
+constexpr auto plugin_abi = ">=2.1.0 <3.0.0 || ^4.0.0"_sr;
+constexpr auto protocol = "2.4.0-rc.1+build.7"_sv;
+
+static_assert(protocol.major() == 2 && protocol.prerelease_tag() == "rc.1" && protocol.build_metadata() == "build.7");
+static_assert(satisfies("2.4.0"_sv, plugin_abi));
+static_assert(satisfies("4.1.0"_sv, plugin_abi));
+static_assert(!satisfies(protocol, plugin_abi));
+static_assert(satisfies(protocol, plugin_abi, version_compare_option::include_prerelease));
+static_assert("1.0.0-alpha"_sv < "1.0.0-alpha.1"_sv && "1.0.0-beta.11"_sv < "1.0.0-rc.1"_sv && "1.0.0-rc.1"_sv < "1.0.0"_sv);
+#endif
+
+TEST_CASE("static versions and ranges") {
+  constexpr std::array<std::string_view, 12> ranges = {{
+    {">=1.0.0 <2.0.0"},
+    {">1.0.0-alpha"},
+    {">=1.0.0-alpha.1 <1.0.0"},
+    {"<=1.0.0-rc.1 || >=2.0.0"},
+    {"1.0.0"},
+    {"^1.1"},
+    {"~1.0.0-alpha.beta"},
+    {"1.x || 10.20.30 - 99999"},
+    {"*"},
+    {">2.0.0 <1.0.0"},
+    {"^0.0.4"},
+    {"<1.1.2-prerelease"}
+  }};
+
+  for (auto range_str : ranges) {
+    range_set<> r;
+    static_range_set<64> sr;
+    REQUIRE(parse(range_str, r));
+    REQUIRE(parse(range_str, sr));
+
+    for (auto version_str : valid_versions) {
+      version<> v;
+      static_version<> sv;
+      REQUIRE(parse(version_str, v));
+      REQUIRE(parse(version_str, sv));
+
+      for (auto option : {version_compare_option::exclude_prerelease, version_compare_option::include_prerelease}) {
+        CHECK(satisfies(sv, sr, option) == r.contains(v, option));
+      }
+    }
+  }
+
+  for (auto lhs_str : valid_versions) {
+    for (auto rhs_str : valid_versions) {
+      version<> lhs;
+      version<> rhs;
+      static_version<> static_lhs;
+      static_version<> static_rhs;
+      REQUIRE(parse(lhs_str, lhs));
+      REQUIRE(parse(rhs_str, rhs));
+      REQUIRE(parse(lhs_str, static_lhs));
+      REQUIRE(parse(rhs_str, static_rhs));
+      CHECK((static_lhs < static_rhs) == (lhs < rhs));
+      CHECK((static_lhs == static_rhs) == (lhs == rhs));
+    }
+  }
+
+  for (auto str : invalid_versions) {
+    static_version<> v;
+    CHECK_FALSE(parse(str, v));
+  }
+}
+
+TEST_CASE("runtime, static and incremental range parsing agree") {
+  // range_set and static_range_set share range_scanner, the incremental parser has an automaton
+  // of its own, so check them against each other on arbitrary text
+  constexpr std::string_view alphabet = "0123456789....-+ab xX*^~<>=|!";
+  std::mt19937 rng{ 2024 };
+  std::vector<std::string> inputs = { "01.2.3", ">01.2.3", "1.01", "0.x01", "2.001x", "1x", "^1.2.3 || 1.2 - 2", "1.2.3-rc.1+b.2 <2" };
+  for (int i = 0; i < 20000; ++i) {
+    std::string str(1 + rng() % 14, ' ');
+    for (auto& c : str) {
+      c = alphabet[rng() % alphabet.size()];
+    }
+    inputs.push_back(std::move(str));
+  }
+
+  for (const auto& str : inputs) {
+    INFO(str);
+    range_set<> r;
+    const auto result = parse(str, r);
+    const bool parsed = result && result.ptr == str.data() + str.size();
+
+    static_range_set<16> sr;
+    const auto static_result = parse(str, sr);
+    REQUIRE(static_result.ec == result.ec);
+    REQUIRE(static_result.ptr == result.ptr);
+
+    incremental_parser<range_set<>> parser;
+    std::vector<range_set<>> values;
+    const auto collect = [&](range_set<>& value) { values.push_back(std::move(value)); };
+    const bool incremental = parser.feed(str, collect) && parser.finish(collect) && values.size() == 1;
+    REQUIRE(incremental == parsed);
+
+    if (parsed) {
+      REQUIRE(values[0].to_string() == r.to_string());
+      for (auto version_str : valid_versions) {
+        version<> v;
+        static_version<> sv;
+        REQUIRE(parse(version_str, v));
+        REQUIRE(parse(version_str, sv));
+        CHECK(satisfies(sv, sr) == r.contains(v));
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#include <semver_io.hpp>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "test_utils.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <unistd.h>
+#endif
+
+using namespace semver;
+
+TEST_CASE("stream reader") {
+  const std::string input = "1.2.3\n\n2.0.0-rc.1+build\r\n1.2\n  \n10.20.30-alpha.01\n3.0.0";
+
+  for (std::size_t block_size : { std::size_t{1}, std::size_t{4}, std::size_t{7}, stream_reader::default_block_size }) {
+    INFO(block_size);
+    std::istringstream in{ input };
+    stream_reader reader{ in, block_size };
+    version<> v;
+
+    REQUIRE(reader.read(v));
+    REQUIRE(v.to_string() == "1.2.3");
+    REQUIRE(reader.line() == 1);
+
+    REQUIRE(reader.read(v));
+    REQUIRE(v.to_string() == "2.0.0-rc.1+build");
+    REQUIRE(reader.line() == 3);
+
+    REQUIRE_FALSE(reader.read(v));
+    REQUIRE(reader.error().ec == std::errc::invalid_argument);
+    REQUIRE(reader.error().line == 4);
+    REQUIRE(reader.error().column == 4);
+
+    REQUIRE_FALSE(reader.read(v));
+    REQUIRE(reader.error().line == 5);
+    REQUIRE(reader.error().column == 1);
+
+    REQUIRE_FALSE(reader.read(v));
+    REQUIRE(reader.error().line == 6);
+    REQUIRE(reader.error().column == 16);
+
+    REQUIRE(reader.read(v));
+    REQUIRE(v.to_string() == "3.0.0");
+    REQUIRE(reader.line() == 7);
+
+    REQUIRE_FALSE(reader.read(v));
+    REQUIRE(reader.error().ec == std::errc{});
+    REQUIRE_FALSE(reader.read(v));
+  }
+
+  SECTION("any parsable type") {
+    std::istringstream in{ "1.2.3\n>=1.0.0 <2.0.0\n>=1.3.0 garbage\n^2.0.0" };
+    stream_reader reader{ in };
+    core_version<> core;
+    REQUIRE(reader.read(core));
+    REQUIRE(core == core_version<>{ 1, 2, 3 });
+    range_set<> range;
+    REQUIRE(reader.read(range));
+    REQUIRE(range.contains(core));
+
+    // the whole line must be a range set
+    REQUIRE_FALSE(reader.read(range));
+    REQUIRE(reader.error().ec == std::errc::invalid_argument);
+    REQUIRE(reader.error().line == 3);
+    REQUIRE(reader.error().column == 9);
+    REQUIRE(reader.read(range));
+    REQUIRE(range.to_string() == ">=2.0.0 <3.0.0-0");
+  }
+
+  SECTION("long lines") {
+    std::string long_input;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 200; ++i) {
+      expected.push_back("1.2." + std::to_string(i) + "-" + std::string(static_cast<std::size_t>(i) + 1, 'a'));
+      long_input += expected.back() + "\n";
+    }
+
+    std::istringstream in{ long_input };
+    stream_reader reader{ in, 16 };
+    version<> v;
+    for (const auto& str : expected) {
+      REQUIRE(reader.read(v));
+      REQUIRE(v.to_string() == str);
+    }
+    REQUIRE_FALSE(reader.read(v));
+    REQUIRE(reader.error().ec == std::errc{});
+  }
+
+#if defined(__unix__) || defined(__APPLE__)
+  SECTION("file descriptor") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    const std::string text = "1.0.0\n2.0.0\n";
+    REQUIRE(::write(fds[1], text.data(), text.size()) == static_cast<::ssize_t>(text.size()));
+    ::close(fds[1]);
+
+    stream_reader reader{ fds[0], 4 };
+    version<> v;
+    REQUIRE(reader.read(v));
+    REQUIRE(v.major() == 1);
+    REQUIRE(reader.read(v));
+    REQUIRE(v.major() == 2);
+    REQUIRE_FALSE(reader.read(v));
+    REQUIRE(reader.error().ec == std::errc{});
+    ::close(fds[0]);
+  }
+#endif
+}
@@ -1,5 +1,6 @@
 #include <semver.hpp>
 #include <catch.hpp>
+#include <array>
 #include "test_utils.hpp"
 
 using namespace semver;
@@ -12,4 +13,53 @@ TEST_CASE("to string") {
     REQUIRE(parse(str, version));
     CHECK(version.to_string() == str);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("range to string") {
+  constexpr std::array<std::array<std::string_view, 2>, 14> ranges = {{
+    {{">=1.0.0 <2.0.0", ">=1.0.0 <2.0.0"}},
+    {{">= 1.0.0  <2.0.0", ">=1.0.0 <2.0.0"}},
+    {{"<2.0.0 >=1.0.0", ">=1.0.0 <2.0.0"}},
+    {{">=0.5.0 <3.0.0 >=1.0.0 <=2.0.0 <2.0.0", ">=1.0.0 <2.0.0"}},
+    {{"=1.2.3+build", "1.2.3"}},
+    {{">=1.2.3 <=1.2.3", "1.2.3"}},
+    {{">=1.5.0 <2.0.0 || >=1.0.0 <1.5.0", ">=1.0.0 <2.0.0"}},
+    {{">=1.0.0 <1.8.0 || >=1.2.0 <2.0.0 || 1.4.0", ">=1.0.0 <2.0.0"}},
+    {{"<=1.0.0 || >1.0.0", "*"}},
+    {{">2.0.0 <1.0.0", "<0.0.0-0"}},
+    {{">3.0.0 || >2.0.0 <1.0.0 || <1.0.0", "<1.0.0 || >3.0.0"}},
+    {{">=1.2.3-alpha <1.3.0 || >=1.2.0 <1.2.5", ">=1.2.0 <1.2.5 || >=1.2.3-alpha <1.3.0"}},
+    {{">=1.2.3-alpha <1.2.4 || >=1.2.3-beta <1.2.3", ">=1.2.3-alpha <1.2.4"}},
+    {{">=1.2.3-alpha <1.2.4 || >=1.2.0 <1.2.4", ">=1.2.0 <1.2.4 || >=1.2.3-alpha <1.2.4"}}
+  }};
+
+  for (const auto& [str, canonical] : ranges) {
+    range_set<> r;
+    REQUIRE(parse(str, r));
+    CHECK(r.to_string() == canonical);
+
+    range_set<> c;
+    REQUIRE(parse(canonical, c));
+    CHECK(c.to_string() == canonical);
+    CHECK(c.canonical_hash() == r.canonical_hash());
+
+    for (auto version_str : valid_versions) {
+      version<> v;
+      REQUIRE(parse(version_str, v));
+      CHECK(c.contains(v) == r.contains(v));
+      CHECK(c.contains(v, version_compare_option::include_prerelease) == r.contains(v, version_compare_option::include_prerelease));
+    }
+
+    std::array<char, 64> buffer{};
+    const auto result = to_chars(buffer.data(), buffer.data() + buffer.size(), r);
+    REQUIRE(result);
+    CHECK(std::string_view(buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data())) == canonical);
+    CHECK_FALSE(to_chars(buffer.data(), buffer.data() + canonical.size() - 1, r));
+  }
+
+  range_set<> a;
+  range_set<> b;
+  REQUIRE(parse(">=1.0.0 <2.0.0", a));
+  REQUIRE(parse(">=1.0.0 <2.0.1", b));
+  CHECK(a.canonical_hash() != b.canonical_hash());
+}
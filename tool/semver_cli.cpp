@@ -0,0 +1,308 @@
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2020 - 2025 Daniil Goncharov <neargye@gmail.com>.
+// Copyright (c) 2020 - 2025 Alexander Gorbunov <naratzul@gmail.com>.
+//
+// Permission is hereby  granted, free of charge, to any  person obtaining a copy
+// of this software and associated  documentation files (the "Software"), to deal
+// in the Software  without restriction, including without  limitation the rights
+// to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+// copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+// IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+// FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+// AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+// LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Bulk sort/filter/validate of newline-delimited versions read from stdin:
+//
+//   semver sort                  versions in ascending precedence
+//   semver filter '<range>'      versions that satisfy the range, in input order
+//   semver valid                 valid versions, invalid lines are reported to stderr
+//   semver max '<range>'         the highest version that satisfies the range
+//
+// Options: --include-prerelease, --threads N (0 = every core), --stats.
+// Without --threads, inputs shorter than 32768 versions are processed on one thread.
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "semver.hpp"
+#include "semver_concurrent.hpp"
+#include "semver_io.hpp"
+
+namespace {
+
+// Below this many versions a single thread is faster than starting the others,
+// so without an explicit --threads smaller inputs stay on one.
+constexpr std::size_t parallel_threshold = 1 << 15;
+
+using clock_type = std::chrono::steady_clock;
+
+struct options {
+  std::string_view command;
+  std::string_view range;
+  semver::version_compare_option option = semver::version_compare_option::exclude_prerelease;
+  unsigned threads = 0;
+  bool explicit_threads = false;
+  bool stats = false;
+};
+
+struct statistics {
+  std::size_t versions = 0;
+  std::size_t invalid = 0;
+  std::size_t written = 0;
+  unsigned threads = 1;
+  double read_ms = 0;
+  double process_ms = 0;
+  double write_ms = 0;
+};
+
+int usage() {
+  std::fputs("usage: semver <sort | valid | filter <range> | max <range>> [--include-prerelease] [--threads N] [--stats]\n"
+             "  --threads N  threads to sort or filter with, 0 = every core;\n"
+             "               by default every core from 32768 versions on, one below that\n", stderr);
+  return 2;
+}
+
+bool parse_options(int argc, char** argv, options& out) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--stats") {
+      out.stats = true;
+    } else if (arg == "--include-prerelease") {
+      out.option = semver::version_compare_option::include_prerelease;
+    } else if (arg == "--threads" && i + 1 < argc) {
+      const std::string_view value = argv[++i];
+      const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), out.threads);
+      if (ec != std::errc{} || ptr != value.data() + value.size()) {
+        return false;
+      }
+      out.explicit_threads = true;
+    } else if (out.command.empty()) {
+      out.command = arg;
+    } else if (out.range.empty() && (out.command == "filter" || out.command == "max")) {
+      out.range = arg;
+    } else {
+      return false;
+    }
+  }
+
+  if (out.command == "sort" || out.command == "valid") {
+    return true;
+  }
+  return (out.command == "filter" || out.command == "max") && !out.range.empty();
+}
+
+double elapsed_ms(clock_type::time_point start) {
+  return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+std::vector<semver::version<>> read_versions(bool report, statistics& stats) {
+#if defined(SEMVER_IO_POSIX)
+  semver::stream_reader reader{ STDIN_FILENO };
+#else
+  std::ios_base::sync_with_stdio(false);
+  semver::stream_reader reader{ std::cin };
+#endif
+
+  std::vector<semver::version<>> versions;
+  semver::version<> v;
+  while (true) {
+    if (reader.read(v)) {
+      versions.push_back(std::move(v));
+      continue;
+    }
+
+    const auto& error = reader.error();
+    if (error.ec == std::errc{}) {
+      break;
+    }
+    if (error.ec == std::errc::io_error) {
+      std::fprintf(stderr, "semver: cannot read the input\n");
+      std::exit(EXIT_FAILURE);
+    }
+    ++stats.invalid;
+    if (report) {
+      std::fprintf(stderr, "semver: line %zu, column %zu: invalid version\n", error.line, error.column);
+    }
+  }
+
+  stats.versions = versions.size();
+  return versions;
+}
+
+// Stable, so versions of equal precedence (different build metadata) keep their input order.
+// Chunks are sorted on every thread, then merged pairwise.
+void sort_versions(std::vector<semver::version<>>& versions, unsigned threads) {
+  const std::size_t chunks = std::min<std::size_t>(threads, versions.size());
+  if (chunks <= 1) {
+    std::stable_sort(versions.begin(), versions.end());
+    return;
+  }
+
+  std::vector<std::size_t> bounds(chunks + 1);
+  for (std::size_t i = 0; i <= chunks; ++i) {
+    bounds[i] = versions.size() * i / chunks;
+  }
+  const auto at = [&](std::size_t i) { return versions.begin() + static_cast<std::ptrdiff_t>(bounds[i]); };
+
+  semver::detail::parallel_for(chunks, threads, [&] {
+    return [&](std::size_t i) { std::stable_sort(at(i), at(i + 1)); };
+  });
+
+  for (std::size_t width = 1; width < chunks; width *= 2) {
+    const std::size_t merges = (chunks - width + 2 * width - 1) / (2 * width);
+    semver::detail::parallel_for(merges, threads, [&] {
+      return [&](std::size_t merge) {
+        const std::size_t i = merge * 2 * width;
+        std::inplace_merge(at(i), at(i + width), at(std::min(i + 2 * width, chunks)));
+      };
+    });
+  }
+}
+
+// Indices of the versions that satisfy the range, in input order.
+std::vector<std::size_t> filter_versions(const std::vector<semver::version<>>& versions, const semver::range_set<>& range,
+                                         semver::version_compare_option option, unsigned threads) {
+  std::vector<std::size_t> result;
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+      if (range.contains(versions[i], option)) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  const semver::version_table<> table{ versions.begin(), versions.end() };
+  const semver::match_matrix matrix = semver::match(table, std::vector<semver::range_set<>>{ range }, option, threads);
+  for (std::size_t i = 0; i < versions.size(); ++i) {
+    if (matrix.test(0, i)) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+class output {
+public:
+  explicit output(statistics& stats) : stats_{&stats} { buffer_.reserve(capacity); }
+
+  output(const output&) = delete;
+  output& operator=(const output&) = delete;
+
+  ~output() { flush(); }
+
+  void write(const semver::version<>& v) {
+    buffer_ += v.to_string();
+    buffer_ += '\n';
+    ++stats_->written;
+    if (buffer_.size() >= capacity) {
+      flush();
+    }
+  }
+
+  void flush() {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+    buffer_.clear();
+  }
+
+private:
+  static constexpr std::size_t capacity = 1 << 16;
+
+  std::string buffer_;
+  statistics* stats_;
+};
+
+void print_statistics(const statistics& stats) {
+  const double total_ms = stats.read_ms + stats.process_ms + stats.write_ms;
+  const auto rate = [](std::size_t count, double ms) { return ms > 0 ? static_cast<double>(count) / ms / 1000.0 : 0.0; };
+
+  std::fprintf(stderr, "versions: %zu read, %zu invalid, %zu written\n", stats.versions, stats.invalid, stats.written);
+  std::fprintf(stderr, "read:     %10.3f ms  %8.2f M versions/s\n", stats.read_ms, rate(stats.versions + stats.invalid, stats.read_ms));
+  std::fprintf(stderr, "process:  %10.3f ms  %u thread%s\n", stats.process_ms, stats.threads, stats.threads == 1 ? "" : "s");
+  std::fprintf(stderr, "write:    %10.3f ms\n", stats.write_ms);
+  std::fprintf(stderr, "total:    %10.3f ms  %8.2f M versions/s\n", total_ms, rate(stats.versions + stats.invalid, total_ms));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  options opts;
+  if (!parse_options(argc, argv, opts)) {
+    return usage();
+  }
+
+  semver::range_set<> range;
+  if (!opts.range.empty()) {
+    if (const auto result = semver::parse(opts.range, range); !result || result.ptr != opts.range.data() + opts.range.size()) {
+      std::fprintf(stderr, "semver: invalid range at column %zu\n", static_cast<std::size_t>(result.ptr - opts.range.data()) + 1);
+      return 2;
+    }
+  }
+
+  statistics stats;
+  auto start = clock_type::now();
+  std::vector<semver::version<>> versions = read_versions(opts.command == "valid", stats);
+  stats.read_ms = elapsed_ms(start);
+
+  if (opts.explicit_threads || versions.size() >= parallel_threshold) {
+    stats.threads = opts.threads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : opts.threads;
+  }
+
+  int status = EXIT_SUCCESS;
+  {
+    output out{ stats };
+    if (opts.command == "sort") {
+      start = clock_type::now();
+      sort_versions(versions, stats.threads);
+      stats.process_ms = elapsed_ms(start);
+
+      start = clock_type::now();
+      for (const auto& v : versions) {
+        out.write(v);
+      }
+    } else if (opts.command == "valid") {
+      start = clock_type::now();
+      for (const auto& v : versions) {
+        out.write(v);
+      }
+      status = stats.invalid == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else {
+      start = clock_type::now();
+      const std::vector<std::size_t> matches = filter_versions(versions, range, opts.option, stats.threads);
+      stats.process_ms = elapsed_ms(start);
+
+      start = clock_type::now();
+      if (opts.command == "filter") {
+        for (const std::size_t i : matches) {
+          out.write(versions[i]);
+        }
+      } else if (!matches.empty()) {
+        out.write(versions[*std::max_element(matches.begin(), matches.end(), [&](std::size_t lhs, std::size_t rhs) { return versions[lhs] < versions[rhs]; })]);
+      }
+      status = matches.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+  }
+  stats.write_ms = elapsed_ms(start);
+
+  if (opts.stats) {
+    print_statistics(stats);
+  }
+  return status;
+}